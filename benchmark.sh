@@ -0,0 +1,12 @@
+#! /bin/sh
+echo "Building benchmark..."
+qmake -makefile -o bench/Makefile src/wserial.pro -config bench DEFINES+="LOGGING_MODE=QDEBUG"
+cd bench
+make -j4
+if [ "$?" -ne 0 ] ; then
+    echo "Build failed!"
+    exit 1
+fi
+echo "Running benchmark..."
+# extra arguments go to QTest, e.g. -iterations 10 or a single benchmark function
+./benchmark "$@"
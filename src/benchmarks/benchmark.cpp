@@ -0,0 +1,438 @@
+#include "benchmark.h"
+#include <QScrollBar>
+
+// large enough for the caches to matter
+#define STREAMSIZE (1024 * 1024)
+#define SCROLLBACK 100000
+// lines kept by the log view benchmarks, far more than a text document can take
+#define LOGVIEWLINES 10000000
+
+namespace {
+
+/**
+ * Builds rows of `columns` numbers with about `digits` digits each, the way a board would print them
+ * and with fields named ch0, ch1 and so on if `named`
+ */
+QByteArray syntheticStream(const int columns, const int digits, int& samples, const bool named = false) {
+    QByteArray stream;
+    stream.reserve(STREAMSIZE + 1024);
+    samples = 0;
+    quint32 state = 12345;
+    while (stream.size() < STREAMSIZE) {
+        for (int column = 0; column < columns; ++column) {
+            state = state * 1103515245 + 12345;
+            QByteArray number = QByteArray::number(state % 1000000007u).rightJustified(digits, '1').right(digits);
+            if (digits > 4) {
+                number.insert(digits / 2, '.');
+            }
+            if (state & 0x100) {
+                number.prepend('-');
+            }
+            if (named) {
+                stream.append("ch").append(QByteArray::number(column)).append('=');
+            }
+            stream.append(number).append(column + 1 < columns ? ',' : '\n');
+        }
+        samples += columns;
+    }
+    return stream;
+}
+
+QVector<QByteArray> split(const QByteArray& stream, const int chunkSize) {
+    QVector<QByteArray> chunks;
+    for (int i = 0; i < stream.size(); i += chunkSize) {
+        chunks << stream.mid(i, chunkSize);
+    }
+    return chunks;
+}
+
+/**
+ * Adds a row for every kernel of the delimiter scanner, to compare them on the same input
+ */
+void addKernelRows(const char* name, const int columns, const int digits) {
+    const QVector<QPair<DelimiterScanner::Kernel, const char*>> kernels = {
+        {DelimiterScanner::Scalar, "scalar"},
+        {DelimiterScanner::Sse2, "SSE2"},
+        {DelimiterScanner::Avx2, "AVX2"}
+    };
+    for (const auto& kernel : kernels) {
+        QTest::newRow(qPrintable(QString("%1, %2").arg(name, kernel.second)))
+            << int(kernel.first) << columns << digits;
+    }
+}
+
+}
+
+Throughput::Throughput() :
+    m_bytes(0),
+    m_samples(0),
+    m_calls(0) {
+    m_timer.start();
+}
+
+void Throughput::add(const qint64 bytes, const qint64 samples, const qint64 calls) {
+    m_bytes += bytes;
+    m_samples += samples;
+    m_calls += calls;
+}
+
+void Throughput::report() const {
+    const qreal seconds = m_timer.nsecsElapsed() / 1e9;
+    QStringList parts;
+    if (m_bytes > 0) {
+        parts << QString("%1 MB/s").arg(m_bytes / seconds / 1e6, 0, 'f', 1);
+    }
+    if (m_samples > 0) {
+        parts << QString("%1 Msamples/s").arg(m_samples / seconds / 1e6, 0, 'f', 2);
+    }
+    if (m_calls > 0) {
+        parts << QString("%1 us per call").arg(seconds * 1e6 / m_calls, 0, 'f', 3);
+    }
+    qInfo("%s", qPrintable(parts.join(", ")));
+}
+
+void WorkerBenchmark::processData_data() {
+    QTest::addColumn<int>("columns");
+    QTest::addColumn<int>("digits");
+    QTest::addColumn<int>("chunkSize");
+    QTest::addColumn<int>("monitorMode");
+
+    QTest::newRow("1 column, 4 KiB chunks") << 1 << 3 << 4096 << int(Worker::MonitorLive);
+    QTest::newRow("4 columns, 4 KiB chunks") << 4 << 6 << 4096 << int(Worker::MonitorLive);
+    QTest::newRow("16 columns, 4 KiB chunks") << 16 << 6 << 4096 << int(Worker::MonitorLive);
+    QTest::newRow("4 long columns, 4 KiB chunks") << 4 << 16 << 4096 << int(Worker::MonitorLive);
+    QTest::newRow("4 columns, 64 B chunks") << 4 << 6 << 64 << int(Worker::MonitorLive);
+    QTest::newRow("4 columns, 7 B chunks") << 4 << 6 << 7 << int(Worker::MonitorLive);
+    QTest::newRow("4 columns, 64 KiB chunks") << 4 << 6 << 65536 << int(Worker::MonitorLive);
+    QTest::newRow("4 columns, 4 KiB chunks, monitor off") << 4 << 6 << 4096 << int(Worker::MonitorOff);
+}
+
+void WorkerBenchmark::processData() {
+    QFETCH(int, columns);
+    QFETCH(int, digits);
+    QFETCH(int, chunkSize);
+    QFETCH(int, monitorMode);
+
+    int samples;
+    const QByteArray stream = syntheticStream(columns, digits, samples);
+    const QVector<QByteArray> chunks = split(stream, chunkSize);
+    Worker worker;
+    worker.plotEnabled = true;
+    worker.setMonitorMode(monitorMode);
+    Throughput throughput;
+    QBENCHMARK {
+        for (const QByteArray& chunk : chunks) {
+            worker.processData(chunk);
+        }
+        throughput.add(stream.size(), samples, chunks.size());
+    }
+    throughput.report();
+}
+
+void LineParserBenchmark::feed_data() {
+    QTest::addColumn<int>("kernel");
+    QTest::addColumn<int>("columns");
+    QTest::addColumn<int>("digits");
+
+    // long lines are where finding the tokens costs the most next to converting them
+    addKernelRows("4 columns", 4, 6);
+    addKernelRows("32 columns", 32, 6);
+    addKernelRows("32 long columns", 32, 16);
+    // up to 4 digits are written without a point, like ADC counts
+    addKernelRows("8 count columns", 8, 4);
+}
+
+void LineParserBenchmark::feed() {
+    QFETCH(int, kernel);
+    QFETCH(int, columns);
+    QFETCH(int, digits);
+
+    if (!DelimiterScanner::isSupported(DelimiterScanner::Kernel(kernel))) {
+        QSKIP("Kernel not supported by this build or CPU");
+    }
+    DelimiterScanner::setKernel(DelimiterScanner::Kernel(kernel));
+    int samples;
+    const QByteArray stream = syntheticStream(columns, digits, samples);
+    const QVector<QByteArray> chunks = split(stream, 4096);
+    LineParser parser;
+    QVector<qreal> values;
+    QVector<int> rowEnds;
+    Throughput throughput;
+    QBENCHMARK {
+        for (const QByteArray& chunk : chunks) {
+            values.resize(0);
+            rowEnds.resize(0);
+            parser.feed(chunk, values, rowEnds);
+        }
+        throughput.add(stream.size(), samples, chunks.size());
+    }
+    throughput.report();
+}
+
+void LineParserBenchmark::named_data() {
+    QTest::addColumn<int>("columns");
+
+    QTest::newRow("4 named columns") << 4;
+    QTest::newRow("32 named columns") << 32;
+}
+
+void LineParserBenchmark::named() {
+    QFETCH(int, columns);
+
+    int samples;
+    const QByteArray stream = syntheticStream(columns, 6, samples, true);
+    const QVector<QByteArray> chunks = split(stream, 4096);
+    LineParser parser;
+    QVector<qreal> values;
+    QVector<int> rowEnds;
+    QVector<int> channels;
+    Throughput throughput;
+    QBENCHMARK {
+        for (const QByteArray& chunk : chunks) {
+            values.resize(0);
+            rowEnds.resize(0);
+            channels.resize(0);
+            parser.feed(chunk, values, rowEnds, nullptr, &channels);
+        }
+        throughput.add(stream.size(), samples, chunks.size());
+    }
+    throughput.report();
+}
+
+void LineParserBenchmark::scan_data() {
+    QTest::addColumn<int>("kernel");
+    QTest::addColumn<int>("columns");
+    QTest::addColumn<int>("digits");
+
+    addKernelRows("32 columns", 32, 6);
+}
+
+void LineParserBenchmark::scan() {
+    QFETCH(int, kernel);
+    QFETCH(int, columns);
+    QFETCH(int, digits);
+
+    if (!DelimiterScanner::isSupported(DelimiterScanner::Kernel(kernel))) {
+        QSKIP("Kernel not supported by this build or CPU");
+    }
+    DelimiterScanner::setKernel(DelimiterScanner::Kernel(kernel));
+    int samples;
+    const QByteArray stream = syntheticStream(columns, digits, samples);
+    QVector<quint64> newlines((stream.size() + 63) / 64);
+    QVector<quint64> separators(newlines.size());
+    Throughput throughput;
+    QBENCHMARK {
+        DelimiterScanner::scan(stream.constData(), stream.size(), newlines.data(), separators.data());
+        throughput.add(stream.size(), 0, 1);
+    }
+    throughput.report();
+}
+
+void LineParserBenchmark::cleanupTestCase() {
+    DelimiterScanner::setKernel(DelimiterScanner::bestKernel());
+}
+
+void PlotterViewBenchmark::plotFrame_data() {
+    QTest::addColumn<int>("columns");
+    QTest::addColumn<int>("rows");
+    QTest::addColumn<int>("xRange");
+
+    QTest::newRow("1 column, 10 rows per frame") << 1 << 10 << 500;
+    QTest::newRow("8 columns, 10 rows per frame") << 8 << 10 << 500;
+    QTest::newRow("8 columns, 1000 rows per frame") << 8 << 1000 << 500;
+    QTest::newRow("8 columns, 1000 rows per frame, wide") << 8 << 1000 << 100000;
+}
+
+void PlotterViewBenchmark::plotFrame() {
+    QFETCH(int, columns);
+    QFETCH(int, rows);
+    QFETCH(int, xRange);
+
+    SampleFrame frame;
+    for (int row = 0; row < rows; ++row) {
+        for (int column = 0; column < columns; ++column) {
+            frame.values << qSin(row * 0.01 + column) * (column + 1);
+        }
+        frame.rowEnds << frame.values.size();
+    }
+    PlotterView plotterView;
+    plotterView.ui->xRangeSpinBox->setValue(xRange);
+    plotterView.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&plotterView));
+    Throughput throughput;
+    // one refresh per frame is the worst case, the refresh timer coalesces them
+    QBENCHMARK {
+        plotterView.plotFrame(frame);
+        plotterView.refresh();
+        throughput.add(0, frame.values.size(), 1);
+    }
+    throughput.report();
+}
+
+void PlotterViewBenchmark::plotPoint() {
+    PlotterView plotterView;
+    plotterView.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&plotterView));
+    Throughput throughput;
+    int x = 0;
+    QBENCHMARK {
+        for (int i = 0; i < 1000; ++i, ++x) {
+            plotterView.plotPoint(qSin(x * 0.01), 0, false);
+            plotterView.plotPoint(qCos(x * 0.01), 1, true);
+        }
+        plotterView.refresh();
+        throughput.add(0, 2000, 2000);
+    }
+    throughput.report();
+}
+
+void LogViewBenchmark::append_data() {
+    QTest::addColumn<int>("lines");
+
+    QTest::newRow("1 line per append") << 1;
+    QTest::newRow("100 lines per append") << 100;
+    QTest::newRow("10000 lines per append") << 10000;
+}
+
+void LogViewBenchmark::append() {
+    QFETCH(int, lines);
+
+    LogView logView;
+    logView.setMaximumLineCount(LOGVIEWLINES);
+    QString text;
+    for (int i = 0; i < lines; ++i) {
+        text += QString("%1, %2, %3\n").arg(i).arg(i * 0.5).arg(-i);
+    }
+    Throughput throughput;
+    QBENCHMARK {
+        logView.append(text);
+        throughput.add(text.size(), 0, 1);
+    }
+    throughput.report();
+}
+
+void LogViewBenchmark::scroll() {
+    LogView logView;
+    logView.setMaximumLineCount(LOGVIEWLINES);
+    QString text;
+    for (int i = 0; i < 10000; ++i) {
+        text += QString("%1, %2, %3\n").arg(i).arg(i * 0.5).arg(-i);
+    }
+    // a full history, only the lines in view are painted however long it is
+    for (int i = 0; i < LOGVIEWLINES / 10000; ++i) {
+        logView.append(text);
+    }
+    logView.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&logView));
+    QScrollBar* scroller = logView.verticalScrollBar();
+    Throughput throughput;
+    int value = 0;
+    QBENCHMARK {
+        value = (value + LOGVIEWLINES / 7) % scroller->maximum();
+        scroller->setValue(value);
+        logView.repaint();
+        throughput.add(0, 0, 1);
+    }
+    throughput.report();
+}
+
+void LineSearcherBenchmark::search_data() {
+    QTest::addColumn<QString>("pattern");
+    QTest::addColumn<bool>("regex");
+
+    // only the last line matches, so the search is done once it is found
+    QTest::newRow("substring") << "-999999" << false;
+    QTest::newRow("regex") << "^999999, \\S+, -\\d+$" << true;
+}
+
+void LineSearcherBenchmark::search() {
+    QFETCH(QString, pattern);
+    QFETCH(bool, regex);
+
+    LineStore store(LOGVIEWLINES);
+    QReadWriteLock lock;
+    QByteArray text;
+    for (int i = 0; i < 1000000; ++i) {
+        text += QString("%1, %2, %3\n").arg(i).arg(i * 0.5).arg(-i).toUtf8();
+    }
+    store.append(text.constData(), text.size());
+    LineSearcher searcher(&store, &lock);
+    QSignalSpy matchesSpy(&searcher, &LineSearcher::matchesFound);
+    Throughput throughput;
+    int generation = 0;
+    QBENCHMARK {
+        matchesSpy.clear();
+        // the whole history, one chunk after the other
+        searcher.setPattern(++generation, pattern, regex);
+        while (matchesSpy.isEmpty()) {
+            QCoreApplication::processEvents();
+        }
+        throughput.add(text.size(), 0, 1);
+    }
+    throughput.report();
+}
+
+MainWindowBenchmark::MainWindowBenchmark()
+    : mainWindow("", "", false)
+{}
+
+void MainWindowBenchmark::initTestCase() {
+    mainWindow.ui->scrollbackSpinBox->setValue(SCROLLBACK);
+    // start from a full scrollback, so every flush also drops old lines
+    // a line at a time, the whole scrollback is more than the queue holds
+    for (int i = 0; i < SCROLLBACK; ++i) {
+        mainWindow.m_queue.pushText(QString("%1, %2, %3\n").arg(i).arg(i * 0.5).arg(-i));
+        mainWindow.drainQueue();
+    }
+    mainWindow.flushOutput();
+    mainWindow.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&mainWindow));
+}
+
+void MainWindowBenchmark::output_data() {
+    QTest::addColumn<int>("lines");
+
+    QTest::newRow("1 line per flush") << 1;
+    QTest::newRow("100 lines per flush") << 100;
+    QTest::newRow("10000 lines per flush") << 10000;
+}
+
+void MainWindowBenchmark::output() {
+    QFETCH(int, lines);
+
+    QString text;
+    for (int i = 0; i < lines; ++i) {
+        text += QString("%1, %2, %3\n").arg(i).arg(i * 0.5).arg(-i);
+    }
+    Throughput throughput;
+    QBENCHMARK {
+        mainWindow.m_queue.pushText(text);
+        mainWindow.drainQueue();
+        mainWindow.flushOutput();
+        throughput.add(text.size(), 0, 1);
+    }
+    throughput.report();
+}
+
+void MainWindowBenchmark::cleanupTestCase() {
+    mainWindow.close();
+}
+
+int main(int argc, char *argv[]) {
+    QApplication app(argc, argv);
+    app.setAttribute(Qt::AA_Use96Dpi, true);
+    WorkerBenchmark workerBenchmark;
+    LineParserBenchmark lineParserBenchmark;
+    PlotterViewBenchmark plotterViewBenchmark;
+    LogViewBenchmark logViewBenchmark;
+    LineSearcherBenchmark lineSearcherBenchmark;
+    MainWindowBenchmark mainWindowBenchmark;
+    QTEST_SET_MAIN_SOURCE_PATH
+
+    return QTest::qExec(&workerBenchmark, argc, argv)
+         + QTest::qExec(&lineParserBenchmark, argc, argv)
+         + QTest::qExec(&plotterViewBenchmark, argc, argv)
+         + QTest::qExec(&logViewBenchmark, argc, argv)
+         + QTest::qExec(&lineSearcherBenchmark, argc, argv)
+         + QTest::qExec(&mainWindowBenchmark, argc, argv);
+}
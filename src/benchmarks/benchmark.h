@@ -0,0 +1,86 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+#include <QtTest/QtTest>
+#include "worker.h"
+#include "lineparser.h"
+#include "delimiterscanner.h"
+#include "logview.h"
+#include "linesearcher.h"
+#include "plotterview.h"
+#include "ui_plotterview.h"
+#include "mainwindow.h"
+#include "ui_mainwindow.h"
+
+/**
+ * Accumulates the work done inside a QBENCHMARK block and reports it as throughput
+ */
+class Throughput {
+public:
+    Throughput();
+    void add(const qint64 bytes, const qint64 samples, const qint64 calls);
+    void report() const;
+
+private:
+    QElapsedTimer m_timer;
+    qint64 m_bytes;
+    qint64 m_samples;
+    qint64 m_calls;
+};
+
+class WorkerBenchmark: public QObject {
+    Q_OBJECT
+private slots:
+    void processData_data();
+    void processData();
+};
+
+class LineParserBenchmark: public QObject {
+    Q_OBJECT
+private slots:
+    void feed_data();
+    void feed();
+    void named_data();
+    void named();
+    void scan_data();
+    void scan();
+    void cleanupTestCase();
+};
+
+class PlotterViewBenchmark: public QObject {
+    Q_OBJECT
+private slots:
+    void plotFrame_data();
+    void plotFrame();
+    void plotPoint();
+};
+
+class LogViewBenchmark: public QObject {
+    Q_OBJECT
+private slots:
+    void append_data();
+    void append();
+    void scroll();
+};
+
+class LineSearcherBenchmark: public QObject {
+    Q_OBJECT
+private slots:
+    void search_data();
+    void search();
+};
+
+class MainWindowBenchmark: public QObject {
+    Q_OBJECT
+    MainWindow mainWindow;
+
+public:
+    MainWindowBenchmark();
+
+private slots:
+    void initTestCase();
+    void output_data();
+    void output();
+    void cleanupTestCase();
+};
+
+#endif // BENCHMARK_H
@@ -0,0 +1,64 @@
+/**
+ * @file bytering.cpp
+ * @brief Implementation of ByteRing class
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#include "bytering.h"
+#include <cstring>
+
+ByteRing::ByteRing(const int capacity) :
+    m_capacity(qMax(capacity, 1)),
+    m_start(0),
+    m_end(0) {}
+
+void ByteRing::setCapacity(const int capacity) {
+    const int newCapacity = qMax(capacity, 1);
+    if (newCapacity == m_capacity) return;
+    const int kept = qMin(size(), newCapacity);
+    QByteArray data(kept, Qt::Uninitialized);
+    copy(m_end - kept, kept, data.data());
+    m_data = data;
+    m_capacity = newCapacity;
+    m_start = 0;
+}
+
+void ByteRing::append(const char* data, const int length) {
+    if (length <= 0) return;
+    m_end += length;
+    if (length >= m_capacity) {
+        // only the newest bytes of a large append fit at all
+        m_data = QByteArray(data + length - m_capacity, m_capacity);
+        m_start = 0;
+        return;
+    }
+    // the data grows until the capacity is reached
+    const int grown = qMin(length, m_capacity - m_data.size());
+    m_data.append(data, grown);
+    // and the rest overwrites the oldest bytes
+    for (int i = grown; i < length;) {
+        const int chunk = qMin(length - i, m_capacity - m_start);
+        memcpy(m_data.data() + m_start, data + i, size_t(chunk));
+        m_start += chunk;
+        if (m_start == m_capacity) m_start = 0;
+        i += chunk;
+    }
+}
+
+void ByteRing::copy(const qint64 offset, const int length, char* out) const {
+    if (length <= 0) return;
+    int p = m_start + int(offset - startOffset());
+    if (p >= m_data.size()) p -= m_data.size();
+    // at most two pieces, before and after the end of the data wraps around
+    const int first = qMin(length, m_data.size() - p);
+    memcpy(out, m_data.constData() + p, size_t(first));
+    memcpy(out + first, m_data.constData(), size_t(length - first));
+}
+
+void ByteRing::clear() {
+    m_data.clear();
+    m_start = 0;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file bytering.h
+ * @brief Fixed-capacity ring buffer holding the newest bytes of a stream
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#ifndef BYTERING_H
+#define BYTERING_H
+
+#include <QByteArray>
+
+class ByteRing {
+public:
+    /**
+     * Constructs an empty buffer at the start of the stream
+     *
+     * @param capacity the maximum number of bytes kept, older ones are overwritten
+     */
+    explicit ByteRing(const int capacity = 1);
+
+    /**
+     * Changes the capacity, keeping the newest bytes that still fit
+     *
+     * @param capacity the new capacity
+     */
+    void setCapacity(const int capacity);
+
+    /**
+     * @return the maximum number of bytes kept
+     */
+    int capacity() const { return m_capacity; }
+
+    /**
+     * @return the number of bytes currently held
+     */
+    int size() const { return m_data.size(); }
+
+    /**
+     * @return the offset in the stream of the oldest byte held
+     */
+    qint64 startOffset() const { return m_end - m_data.size(); }
+
+    /**
+     * @return the offset in the stream one past the newest byte held
+     */
+    qint64 endOffset() const { return m_end; }
+
+    /**
+     * Appends bytes to the stream, overwriting the oldest ones when full
+     *
+     * @param data the bytes
+     * @param length the number of bytes
+     */
+    void append(const char* data, const int length);
+
+    /**
+     * Copies bytes held by the buffer
+     *
+     * @param offset the offset in the stream of the first byte, at least `startOffset()`
+     * @param length the number of bytes, ending at most at `endOffset()`
+     * @param out where the bytes are copied to
+     */
+    void copy(const qint64 offset, const int length, char* out) const;
+
+    /**
+     * Removes all bytes, keeping the capacity and the offset of the stream
+     */
+    void clear();
+
+private:
+    /**
+     * The bytes, which grow until the capacity is reached and then wrap around
+     */
+    QByteArray m_data;
+
+    /**
+     * The maximum number of bytes kept
+     */
+    int m_capacity;
+
+    /**
+     * Position of the oldest byte in `m_data`, only non-zero once the buffer is full
+     */
+    int m_start;
+
+    /**
+     * The offset in the stream one past the newest byte
+     */
+    qint64 m_end;
+};
+
+#endif // BYTERING_H
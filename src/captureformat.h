@@ -0,0 +1,36 @@
+/**
+ * @file captureformat.h
+ * @brief Layout of the capture files written by CaptureWriter
+ *
+ * A capture starts with a header, followed by one chunk per read from the port:
+ *
+ *     header:  magic "WSERCAP1" (8 bytes) | start time in ms since the epoch (int64)
+ *     chunk:   time of the read in ns since the start (int64) | length (uint32) | data
+ *
+ * Chunks are written in blocks. When a capture is closed cleanly, an index with
+ * one entry per block follows the last chunk, and a trailer at the very end of
+ * the file locates it:
+ *
+ *     index:   offset of the first chunk of the block (int64) | its time (int64)
+ *     trailer: offset of the index (int64) | number of entries (uint32) | magic "WSERIDX1"
+ *
+ * All integers are little-endian. A capture without a trailer, for example
+ * after a crash, can still be read chunk by chunk.
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#ifndef CAPTUREFORMAT_H
+#define CAPTUREFORMAT_H
+
+#define CAPTURE_MAGIC "WSERCAP1"
+#define CAPTURE_INDEXMAGIC "WSERIDX1"
+#define CAPTURE_MAGICSIZE 8
+#define CAPTURE_HEADERSIZE 16
+#define CAPTURE_CHUNKHEADERSIZE 12
+#define CAPTURE_INDEXENTRYSIZE 16
+#define CAPTURE_TRAILERSIZE 20
+
+#endif // CAPTUREFORMAT_H
@@ -0,0 +1,133 @@
+/**
+ * @file captureplayer.cpp
+ * @brief Implementation of CapturePlayer class
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#include "captureplayer.h"
+#include "captureformat.h"
+#include "monotonicclock.h"
+#include <QtEndian>
+
+// at most this many bytes are sent before letting other events through
+#define BATCHSIZE (1024 * 1024)
+// how often a full output queue is checked again, in milliseconds
+#define QUEUEPOLLINTERVAL 10
+
+CapturePlayer::CapturePlayer() :
+    m_file(this),
+    m_timer(this),
+    m_speed(0),
+    m_end(0),
+    m_firstTime(0),
+    m_startTime(0),
+    m_bytes(0),
+    m_chunkTime(0),
+    m_hasChunk(false),
+    m_stats(nullptr),
+    m_queue(nullptr) {
+
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &CapturePlayer::step);
+}
+
+void CapturePlayer::play(const QString& path, const qreal speed) {
+    stop();
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        emit errorOccurred(m_file.errorString());
+        return;
+    }
+    const QByteArray header = m_file.read(CAPTURE_HEADERSIZE);
+    if (header.size() != CAPTURE_HEADERSIZE || !header.startsWith(CAPTURE_MAGIC)) {
+        m_file.close();
+        emit errorOccurred("Not a capture file");
+        return;
+    }
+
+    // a capture that was closed cleanly has its index after the last chunk,
+    // otherwise the chunks go on until the end of the file
+    m_end = m_file.size();
+    if (m_end >= CAPTURE_HEADERSIZE + CAPTURE_TRAILERSIZE) {
+        m_file.seek(m_end - CAPTURE_TRAILERSIZE);
+        const QByteArray trailer = m_file.read(CAPTURE_TRAILERSIZE);
+        const qint64 indexOffset = qFromLittleEndian<qint64>(trailer.constData());
+        const qint64 entries = qFromLittleEndian<quint32>(trailer.constData() + 8);
+        if (trailer.mid(12) == QByteArray(CAPTURE_INDEXMAGIC) &&
+                indexOffset + entries * CAPTURE_INDEXENTRYSIZE + CAPTURE_TRAILERSIZE == m_end) {
+            m_end = indexOffset;
+        }
+        m_file.seek(CAPTURE_HEADERSIZE);
+    }
+
+    m_speed = speed > 0 ? speed : 0;
+    m_bytes = 0;
+    m_hasChunk = readChunk();
+    m_firstTime = m_chunkTime;
+    m_startTime = MonotonicClock::now();
+    m_clock.start();
+    step();
+}
+
+void CapturePlayer::stop() {
+    m_timer.stop();
+    m_hasChunk = false;
+    m_chunk.clear();
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+}
+
+void CapturePlayer::step() {
+    qint64 batch = 0;
+    while (m_hasChunk) {
+        if (batch >= BATCHSIZE) {
+            m_timer.start(0);
+            return;
+        }
+        if (m_queue != nullptr && m_queue->isFull()) {
+            // like the reader, wait for the window to catch up
+            m_timer.start(QUEUEPOLLINTERVAL);
+            return;
+        }
+        if (m_speed > 0) {
+            const qint64 due = qint64((m_chunkTime - m_firstTime) / m_speed);
+            const qint64 now = m_clock.nsecsElapsed();
+            if (due > now) {
+                // rounded up, so chunks are never sent early
+                m_timer.start(int((due - now + 999999) / 1000000));
+                return;
+            }
+        }
+        batch += m_chunk.size();
+        m_bytes += m_chunk.size();
+        // as fast as possible still keeps the recorded spacing, so the plot looks as recorded
+        const qint64 time = m_startTime + qint64((m_chunkTime - m_firstTime) / (m_speed > 0 ? m_speed : 1));
+        if (m_stats != nullptr) {
+            m_stats->addBytesRead(m_chunk.size());
+        }
+        emit dataRead(m_chunk, time);
+        m_hasChunk = readChunk();
+    }
+    const qint64 elapsed = m_clock.nsecsElapsed();
+    stop();
+    emit finished(m_bytes, elapsed);
+}
+
+bool CapturePlayer::readChunk() {
+    char header[CAPTURE_CHUNKHEADERSIZE];
+    if (m_file.pos() + CAPTURE_CHUNKHEADERSIZE > m_end ||
+            m_file.read(header, CAPTURE_CHUNKHEADERSIZE) != CAPTURE_CHUNKHEADERSIZE) {
+        return false;
+    }
+    m_chunkTime = qFromLittleEndian<qint64>(header);
+    const qint64 length = qFromLittleEndian<quint32>(header + 8);
+    // the last chunk of a capture that wasn't closed may be cut off
+    if (m_file.pos() + length > m_end) return false;
+    m_chunk = m_file.read(length);
+    return m_chunk.size() == length;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file captureplayer.h
+ * @brief CapturePlayer class for replaying capture files as if they came from the port
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#ifndef CAPTUREPLAYER_H
+#define CAPTUREPLAYER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTimer>
+#include "pipelinestats.h"
+#include "outputqueue.h"
+
+class CapturePlayer : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * Default constructor, takes no arguments
+     */
+    CapturePlayer();
+
+    /**
+     * Sets the counters the player adds to, call before the player is moved to its thread
+     *
+     * @param stats the counters, or nullptr to count nothing
+     */
+    void setStats(PipelineStats* stats) { m_stats = stats; }
+
+    /**
+     * Sets the queue to the window, the replay waits while it is full and blocks the reader
+     *
+     * @param queue the queue, or nullptr to never wait
+     */
+    void setOutputQueue(OutputQueue* queue) { m_queue = queue; }
+
+signals:
+    /**
+     * Sends the next chunk of the capture to the worker, like PortReader::dataRead
+     *
+     * The chunks are stamped as if the recording had started with the replay, keeping the
+     * recorded spacing divided by the speed, or as recorded when replaying as fast as possible
+     *
+     * @param buf the chunk as it was read from the port
+     * @param time when the chunk would have been read, in ns of MonotonicClock
+     */
+    void dataRead(const QByteArray& buf, const qint64 time);
+
+    /**
+     * Emitted when the whole capture has been replayed
+     *
+     * @param bytes the number of bytes replayed
+     * @param elapsed the time the replay took, in ns
+     */
+    void finished(const qint64 bytes, const qint64 elapsed);
+
+    /**
+     * Emitted when the capture file can't be opened or is not a capture
+     *
+     * @param message description of the error
+     */
+    void errorOccurred(const QString& message);
+
+public slots:
+    /**
+     * Starts replaying a capture, stopping the current replay
+     *
+     * @param path the path of the capture file
+     * @param speed how many times faster than recorded to replay, or 0 for as fast as possible
+     */
+    void play(const QString& path, const qreal speed);
+
+    /**
+     * Stops replaying without emitting `finished`
+     */
+    void stop();
+
+private slots:
+    /**
+     * Sends all chunks that are due, and schedules the next step
+     */
+    void step();
+
+private:
+    /**
+     * The capture file being replayed
+     */
+    QFile m_file;
+
+    /**
+     * Schedules the next step
+     */
+    QTimer m_timer;
+
+    /**
+     * Time since the replay started
+     */
+    QElapsedTimer m_clock;
+
+    /**
+     * How many times faster than recorded to replay, 0 for as fast as possible
+     */
+    qreal m_speed;
+
+    /**
+     * Offset in the file where the chunks end
+     */
+    qint64 m_end;
+
+    /**
+     * Recorded time of the first chunk
+     */
+    qint64 m_firstTime;
+
+    /**
+     * Time of MonotonicClock at which the replay started, in ns
+     */
+    qint64 m_startTime;
+
+    /**
+     * Number of bytes replayed so far
+     */
+    qint64 m_bytes;
+
+    /**
+     * The next chunk to send, read ahead to know when it is due
+     */
+    QByteArray m_chunk;
+
+    /**
+     * Recorded time of `m_chunk`
+     */
+    qint64 m_chunkTime;
+
+    /**
+     * Whether `m_chunk` holds a chunk that hasn't been sent yet
+     */
+    bool m_hasChunk;
+
+    /**
+     * Counters of the pipeline, not owned by the player
+     */
+    PipelineStats* m_stats;
+
+    /**
+     * Queue to the window, not owned by the player
+     */
+    OutputQueue* m_queue;
+
+    /**
+     * Reads the next chunk into `m_chunk`
+     *
+     * @return whether there was a complete chunk left
+     */
+    bool readChunk();
+};
+
+#endif // CAPTUREPLAYER_H
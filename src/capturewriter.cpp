@@ -0,0 +1,125 @@
+/**
+ * @file capturewriter.cpp
+ * @brief Implementation of CaptureWriter class
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#include "capturewriter.h"
+#include "captureformat.h"
+#include <QDateTime>
+#include <QtEndian>
+#include <cstring>
+
+// queued chunks are handed to the writer thread once they reach this size
+#define FLUSHSIZE (256 * 1024)
+// and at least this often, in milliseconds
+#define FLUSHINTERVAL 250
+// chunks are dropped rather than queued past this size, when the disk can't keep up
+#define MAXFRONTSIZE (64 * FLUSHSIZE)
+
+CaptureWriter::CaptureWriter() :
+    m_file(this),
+    m_flushTimer(this),
+    m_frontTime(0),
+    m_flushQueued(false),
+    m_droppedChunks(0),
+    m_fileSize(0) {
+
+    m_front.reserve(FLUSHSIZE * 2);
+    m_back.reserve(FLUSHSIZE * 2);
+    m_flushTimer.setInterval(FLUSHINTERVAL);
+    connect(&m_flushTimer, &QTimer::timeout, this, &CaptureWriter::flush);
+}
+
+void CaptureWriter::record(const QByteArray& buf) {
+    const qint64 time = m_clock.nsecsElapsed();
+    char header[CAPTURE_CHUNKHEADERSIZE];
+    qToLittleEndian<qint64>(time, header);
+    qToLittleEndian<quint32>(quint32(buf.size()), header + 8);
+
+    QMutexLocker locker(&m_mutex);
+    if (m_front.size() + CAPTURE_CHUNKHEADERSIZE + buf.size() > MAXFRONTSIZE) {
+        ++m_droppedChunks;
+        return;
+    }
+    if (m_front.isEmpty()) {
+        m_frontTime = time;
+    }
+    m_front.append(header, CAPTURE_CHUNKHEADERSIZE).append(buf);
+    // the reader never waits for the disk, it only hands over a full buffer
+    if (m_front.size() >= FLUSHSIZE && !m_flushQueued) {
+        m_flushQueued = true;
+        QMetaObject::invokeMethod(this, "flush", Qt::QueuedConnection);
+    }
+}
+
+qint64 CaptureWriter::droppedChunks() {
+    QMutexLocker locker(&m_mutex);
+    return m_droppedChunks;
+}
+
+bool CaptureWriter::open(const QString& path) {
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        emit errorOccurred(m_file.errorString());
+        return false;
+    }
+    m_fileSize = 0;
+    m_index.resize(0);
+    {
+        QMutexLocker locker(&m_mutex);
+        m_droppedChunks = 0;
+    }
+    QByteArray header(CAPTURE_MAGIC, CAPTURE_MAGICSIZE);
+    header.resize(CAPTURE_HEADERSIZE);
+    qToLittleEndian<qint64>(QDateTime::currentMSecsSinceEpoch(), header.data() + CAPTURE_MAGICSIZE);
+    if (!write(header)) return false;
+    m_clock.start();
+    m_flushTimer.start();
+    return true;
+}
+
+void CaptureWriter::close() {
+    m_flushTimer.stop();
+    flush();
+    if (!m_file.isOpen()) return;
+    const qint64 indexOffset = m_fileSize;
+    QByteArray trailer(CAPTURE_TRAILERSIZE, '\0');
+    qToLittleEndian<qint64>(indexOffset, trailer.data());
+    qToLittleEndian<quint32>(quint32(m_index.size() / CAPTURE_INDEXENTRYSIZE), trailer.data() + 8);
+    memcpy(trailer.data() + 12, CAPTURE_INDEXMAGIC, CAPTURE_MAGICSIZE);
+    if (write(m_index) && write(trailer)) {
+        m_file.close();
+    }
+}
+
+void CaptureWriter::flush() {
+    qint64 time;
+    {
+        QMutexLocker locker(&m_mutex);
+        m_flushQueued = false;
+        m_front.swap(m_back);
+        time = m_frontTime;
+    }
+    if (!m_back.isEmpty() && m_file.isOpen()) {
+        char entry[CAPTURE_INDEXENTRYSIZE];
+        qToLittleEndian<qint64>(m_fileSize, entry);
+        qToLittleEndian<qint64>(time, entry + 8);
+        m_index.append(entry, CAPTURE_INDEXENTRYSIZE);
+        write(m_back);
+    }
+    m_back.resize(0);
+}
+
+bool CaptureWriter::write(const QByteArray& buf) {
+    if (m_file.write(buf) != buf.size()) {
+        emit errorOccurred(m_file.errorString());
+        m_file.close();
+        return false;
+    }
+    m_fileSize += buf.size();
+    return true;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file capturewriter.h
+ * @brief CaptureWriter class for recording port input to disk in a separate thread
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#ifndef CAPTUREWRITER_H
+#define CAPTUREWRITER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutex>
+#include <QTimer>
+
+class CaptureWriter : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * Default constructor, takes no arguments
+     */
+    CaptureWriter();
+
+    /**
+     * Queues a buffer read from the port, stamped with the current time
+     *
+     * Only copies the buffer, the file is written in the writer's own thread,
+     * so this is safe to call from the reader thread while the capture is open.
+     * The buffer is dropped when too much is already waiting for the disk
+     *
+     * @param buf the buffer read from the port
+     */
+    void record(const QByteArray& buf);
+
+    /**
+     * Number of buffers dropped by `record` since the capture was opened
+     *
+     * @return the number of dropped buffers
+     */
+    qint64 droppedChunks();
+
+signals:
+    /**
+     * Emitted when the capture file can't be opened or written
+     *
+     * @param message description of the error
+     */
+    void errorOccurred(const QString& message);
+
+public slots:
+    /**
+     * Creates the capture file, replacing an existing one, and writes its header
+     *
+     * @param path the path of the capture file
+     * @return whether the file was created
+     */
+    bool open(const QString& path);
+
+    /**
+     * Writes everything queued and the index, and closes the capture file
+     */
+    void close();
+
+private slots:
+    /**
+     * Swaps the buffers and writes out the one filled by `record`
+     */
+    void flush();
+
+private:
+    /**
+     * The capture file
+     */
+    QFile m_file;
+
+    /**
+     * Writes out the queued chunks periodically, when they are too few to trigger a flush
+     */
+    QTimer m_flushTimer;
+
+    /**
+     * Monotonic clock for the chunk times, started when the capture is opened
+     */
+    QElapsedTimer m_clock;
+
+    /**
+     * Guards the front buffer and the state that goes with it
+     */
+    QMutex m_mutex;
+
+    /**
+     * Chunks queued by `record`, guarded by `m_mutex`
+     */
+    QByteArray m_front;
+
+    /**
+     * Time of the first chunk in the front buffer, guarded by `m_mutex`
+     */
+    qint64 m_frontTime;
+
+    /**
+     * Whether a flush has been queued since the last one, guarded by `m_mutex`
+     */
+    bool m_flushQueued;
+
+    /**
+     * Number of chunks dropped because the front buffer was full, guarded by `m_mutex`
+     */
+    qint64 m_droppedChunks;
+
+    /**
+     * Chunks being written out, only used in the writer's thread
+     */
+    QByteArray m_back;
+
+    /**
+     * Index entries of all blocks written so far
+     */
+    QByteArray m_index;
+
+    /**
+     * Number of bytes written to the capture file
+     */
+    qint64 m_fileSize;
+
+    /**
+     * Writes the buffer at the end of the capture file, closing it on failure
+     *
+     * @return whether the whole buffer was written
+     */
+    bool write(const QByteArray& buf);
+};
+
+#endif // CAPTUREWRITER_H
@@ -0,0 +1,75 @@
+/**
+ * @file channeltable.cpp
+ * @brief Implementation of ChannelTable class
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#include "channeltable.h"
+#include <cstring>
+
+// names kept at most, so garbage on the line can't grow the table forever
+#define MAXCHANNELS 1024
+// slots of an empty table, a power of two
+#define INITIALSLOTS 64
+
+namespace {
+
+/**
+ * FNV-1a, which is quick for the short names of channels
+ */
+inline quint32 hashName(const char* name, const int length) {
+    quint32 hash = 2166136261u;
+    for (int i = 0; i < length; ++i) {
+        hash = (hash ^ quint8(name[i])) * 16777619u;
+    }
+    return hash;
+}
+
+}
+
+ChannelTable::ChannelTable() :
+    m_slots(INITIALSLOTS, -1) {
+    m_offsets << 0;
+}
+
+int ChannelTable::intern(const char* name, const int length) {
+    const quint32 hash = hashName(name, length);
+    const int mask = m_slots.size() - 1;
+    int slot = int(hash & quint32(mask));
+    for (;; slot = (slot + 1) & mask) {
+        const int id = m_slots[slot];
+        if (id < 0) break;
+        if (m_hashes[id] == hash && m_offsets[id + 1] - m_offsets[id] == length
+                && memcmp(m_arena.constData() + m_offsets[id], name, size_t(length)) == 0) {
+            return id;
+        }
+    }
+    if (size() == MAXCHANNELS) return -1;
+
+    const int id = size();
+    m_arena.append(name, length);
+    m_offsets << m_arena.size();
+    m_hashes << hash;
+    m_names << QString::fromUtf8(name, length);
+    m_slots[slot] = id;
+    // at most half full, so probes stay short
+    if (2 * size() > m_slots.size()) {
+        grow();
+    }
+    return id;
+}
+
+void ChannelTable::grow() {
+    m_slots.fill(-1, m_slots.size() * 2);
+    const int mask = m_slots.size() - 1;
+    for (int id = 0; id < size(); ++id) {
+        int slot = int(m_hashes[id] & quint32(mask));
+        while (m_slots[slot] >= 0) {
+            slot = (slot + 1) & mask;
+        }
+        m_slots[slot] = id;
+    }
+}
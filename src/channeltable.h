@@ -0,0 +1,78 @@
+/**
+ * @file channeltable.h
+ * @brief Interns the names of named channels into small integer ids
+ *
+ * Looking up a name hashes its bytes in place and probes an open-addressing table,
+ * so nothing is allocated unless the name is new.
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#ifndef CHANNELTABLE_H
+#define CHANNELTABLE_H
+
+#include <QByteArray>
+#include <QStringList>
+#include <QVector>
+
+class ChannelTable {
+public:
+    /**
+     * Constructs an empty table
+     */
+    ChannelTable();
+
+    /**
+     * Finds the id of a name, adding the name if it is new
+     *
+     * @param name the name, UTF-8 encoded
+     * @param length the number of bytes of the name
+     * @return the id, counting up from 0 in the order names are added, or -1 if the table is full
+     */
+    int intern(const char* name, const int length);
+
+    /**
+     * @return the number of names
+     */
+    int size() const { return m_names.size(); }
+
+    /**
+     * @return the names by id, implicitly shared so copies are free until a name is added
+     */
+    const QStringList& names() const { return m_names; }
+
+private:
+    /**
+     * The names back to back, as they were interned
+     */
+    QByteArray m_arena;
+
+    /**
+     * For every id, the offset of its name in `m_arena`, and one more for the end of the last name
+     */
+    QVector<int> m_offsets;
+
+    /**
+     * For every id, the hash of its name, so most mismatches are found without comparing bytes
+     */
+    QVector<quint32> m_hashes;
+
+    /**
+     * The ids by hash, -1 for an empty slot, with a size that is a power of two
+     */
+    QVector<int> m_slots;
+
+    /**
+     * The names by id
+     */
+    QStringList m_names;
+
+    /**
+     * Doubles the number of slots and puts every id back in its slot
+     */
+    void grow();
+};
+
+#endif // CHANNELTABLE_H
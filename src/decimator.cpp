@@ -0,0 +1,51 @@
+/**
+ * @file decimator.cpp
+ * @brief Implementation of MinMaxDecimator class
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#include "decimator.h"
+
+MinMaxDecimator::MinMaxDecimator() :
+    m_first(0),
+    m_width(0) {}
+
+void MinMaxDecimator::setBucketWidth(const int width) {
+    m_width = width > 0 ? width : 0;
+    clear();
+}
+
+void MinMaxDecimator::discardBefore(const int x) {
+    if (m_width == 0) return;
+    const int index = x >= 0 ? x / m_width : (x + 1) / m_width - 1;
+    while (m_first < m_buckets.size() && m_buckets[m_first].index < index) {
+        ++m_first;
+    }
+    // only move the remaining buckets once half of the storage is unused
+    if (m_first > 64 && m_first * 2 > m_buckets.size()) {
+        m_buckets.remove(0, m_first);
+        m_first = 0;
+    }
+}
+
+void MinMaxDecimator::points(QVector<QPointF>& points) const {
+    for (int i = m_first; i < m_buckets.size(); ++i) {
+        const Bucket& bucket = m_buckets[i];
+        // keep both extremes so peaks stay visible, in x order so the line doesn't fold back
+        if (bucket.minX < bucket.maxX) {
+            points << QPointF(bucket.minX, bucket.min) << QPointF(bucket.maxX, bucket.max);
+        } else if (bucket.maxX < bucket.minX) {
+            points << QPointF(bucket.maxX, bucket.max) << QPointF(bucket.minX, bucket.min);
+        } else {
+            points << QPointF(bucket.minX, bucket.min);
+        }
+    }
+}
+
+void MinMaxDecimator::clear() {
+    m_buckets.clear();
+    m_first = 0;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file decimator.h
+ * @brief Min/max decimation of one line of the plotter down to a few points per pixel column
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#ifndef DECIMATOR_H
+#define DECIMATOR_H
+
+#include <QPointF>
+#include <QVector>
+
+class MinMaxDecimator {
+public:
+    /**
+     * Constructs a disabled decimator
+     */
+    MinMaxDecimator();
+
+    /**
+     * Changes the number of x-values covered by one bucket, dropping all buckets
+     *
+     * @param width the new bucket width, or 0 to disable the decimator
+     */
+    void setBucketWidth(const int width);
+
+    /**
+     * @return the number of x-values covered by one bucket, 0 when disabled
+     */
+    int bucketWidth() const { return m_width; }
+
+    /**
+     * Adds a sample to the newest bucket, starting a new one when x is past it
+     *
+     * x-values must be appended in ascending order
+     *
+     * @param x the x-value of the sample
+     * @param y the y-value of the sample
+     */
+    inline void append(const int x, const qreal y);
+
+    /**
+     * Drops the buckets that end before the given x-value
+     *
+     * @param x the smallest x-value that is still needed
+     */
+    void discardBefore(const int x);
+
+    /**
+     * Appends the minimum and maximum of every bucket, in the order they were plotted
+     *
+     * @param points the list of points to append to
+     */
+    void points(QVector<QPointF>& points) const;
+
+    /**
+     * Removes all buckets, keeping the bucket width
+     */
+    void clear();
+
+private:
+    /**
+     * The extremes of all samples whose x-values fall into the same bucket
+     */
+    struct Bucket {
+        int index;
+        int minX;
+        qreal min;
+        int maxX;
+        qreal max;
+    };
+
+    /**
+     * The buckets, oldest first, starting at `m_first`
+     */
+    QVector<Bucket> m_buckets;
+
+    /**
+     * Position of the oldest bucket still in use, the ones before it are removed in batches
+     */
+    int m_first;
+
+    /**
+     * The number of x-values covered by one bucket, 0 when disabled
+     */
+    int m_width;
+};
+
+inline void MinMaxDecimator::append(const int x, const qreal y) {
+    if (m_width == 0) return;
+    // buckets are aligned to multiples of the width, so they never move as the plot scrolls
+    const int index = x >= 0 ? x / m_width : (x + 1) / m_width - 1;
+    if (m_buckets.size() > m_first && m_buckets.last().index == index) {
+        Bucket& bucket = m_buckets.last();
+        if (y < bucket.min) {
+            bucket.min = y;
+            bucket.minX = x;
+        }
+        if (y > bucket.max) {
+            bucket.max = y;
+            bucket.maxX = x;
+        }
+    } else {
+        m_buckets.append({index, x, y, x, y});
+    }
+}
+
+#endif // DECIMATOR_H
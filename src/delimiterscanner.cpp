@@ -0,0 +1,171 @@
+/**
+ * @file delimiterscanner.cpp
+ * @brief Implementation of DelimiterScanner class
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#include "delimiterscanner.h"
+
+// SSE2 is part of every x86-64 CPU, so it needs no check at runtime
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SCAN_SSE2
+#include <emmintrin.h>
+#endif
+
+// the AVX2 kernel alone is built for AVX2, so the program still runs on CPUs without it
+#if defined(SCAN_SSE2) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SCAN_AVX2
+#include <immintrin.h>
+#endif
+
+// bytes covered by one word of a bitmap
+#define WORDBYTES 64
+
+namespace {
+
+typedef void (*ScanFunction)(const char* data, const int length, quint64* newlines, quint64* separators);
+
+/**
+ * Classifies up to one word's worth of bytes one at a time
+ */
+inline void scanWord(const char* data, const int length, quint64& newlines, quint64& separators) {
+    quint64 newlineBits = 0;
+    quint64 separatorBits = 0;
+    for (int i = 0; i < length; ++i) {
+        const char c = data[i];
+        newlineBits |= quint64(c == '\n') << i;
+        separatorBits |= quint64(c == ',' || c == ' ' || c == '\t') << i;
+    }
+    newlines = newlineBits;
+    separators = separatorBits;
+}
+
+void scanScalar(const char* data, const int length, quint64* newlines, quint64* separators) {
+    for (int i = 0, word = 0; i < length; i += WORDBYTES, ++word) {
+        scanWord(data + i, qMin(WORDBYTES, length - i), newlines[word], separators[word]);
+    }
+}
+
+#ifdef SCAN_SSE2
+void scanSse2(const char* data, const int length, quint64* newlines, quint64* separators) {
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const int words = length / WORDBYTES;
+    for (int word = 0; word < words; ++word) {
+        const char* p = data + word * WORDBYTES;
+        quint64 newlineBits = 0;
+        quint64 separatorBits = 0;
+        for (int i = 0; i < WORDBYTES; i += 16) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+            const __m128i separator = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, comma), _mm_cmpeq_epi8(chunk, space)),
+                _mm_cmpeq_epi8(chunk, tab));
+            newlineBits |= quint64(quint32(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline)))) << i;
+            separatorBits |= quint64(quint32(_mm_movemask_epi8(separator))) << i;
+        }
+        newlines[word] = newlineBits;
+        separators[word] = separatorBits;
+    }
+    if (length % WORDBYTES != 0) {
+        scanWord(data + words * WORDBYTES, length % WORDBYTES, newlines[words], separators[words]);
+    }
+}
+#endif
+
+#ifdef SCAN_AVX2
+__attribute__((target("avx2")))
+void scanAvx2(const char* data, const int length, quint64* newlines, quint64* separators) {
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const int words = length / WORDBYTES;
+    for (int word = 0; word < words; ++word) {
+        const char* p = data + word * WORDBYTES;
+        quint64 newlineBits = 0;
+        quint64 separatorBits = 0;
+        for (int i = 0; i < WORDBYTES; i += 32) {
+            const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+            const __m256i separator = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(chunk, comma), _mm256_cmpeq_epi8(chunk, space)),
+                _mm256_cmpeq_epi8(chunk, tab));
+            newlineBits |= quint64(quint32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, newline)))) << i;
+            separatorBits |= quint64(quint32(_mm256_movemask_epi8(separator))) << i;
+        }
+        newlines[word] = newlineBits;
+        separators[word] = separatorBits;
+    }
+    if (length % WORDBYTES != 0) {
+        scanWord(data + words * WORDBYTES, length % WORDBYTES, newlines[words], separators[words]);
+    }
+}
+#endif
+
+bool cpuHasAvx2() {
+#ifdef SCAN_AVX2
+    // may run before the compiler's own constructor has looked at the CPU
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+ScanFunction scanFunction(const DelimiterScanner::Kernel kernel) {
+    switch (kernel) {
+#ifdef SCAN_AVX2
+    case DelimiterScanner::Avx2:
+        return scanAvx2;
+#endif
+#ifdef SCAN_SSE2
+    case DelimiterScanner::Sse2:
+        return scanSse2;
+#endif
+    default:
+        return scanScalar;
+    }
+}
+
+DelimiterScanner::Kernel currentKernel = DelimiterScanner::bestKernel();
+ScanFunction currentScan = scanFunction(currentKernel);
+
+}
+
+void DelimiterScanner::scan(const char* data, const int length, quint64* newlines, quint64* separators) {
+    currentScan(data, length, newlines, separators);
+}
+
+DelimiterScanner::Kernel DelimiterScanner::bestKernel() {
+    static const Kernel best = isSupported(Avx2) ? Avx2 : isSupported(Sse2) ? Sse2 : Scalar;
+    return best;
+}
+
+bool DelimiterScanner::isSupported(const Kernel kernel) {
+    switch (kernel) {
+    case Avx2:
+        return cpuHasAvx2();
+    case Sse2:
+#ifdef SCAN_SSE2
+        return true;
+#else
+        return false;
+#endif
+    default:
+        return true;
+    }
+}
+
+DelimiterScanner::Kernel DelimiterScanner::kernel() {
+    return currentKernel;
+}
+
+void DelimiterScanner::setKernel(const Kernel kernel) {
+    if (!isSupported(kernel)) return;
+    currentKernel = kernel;
+    currentScan = scanFunction(kernel);
+}
@@ -0,0 +1,64 @@
+/**
+ * @file delimiterscanner.h
+ * @brief Vectorized classification of the line and token delimiters in the serial input
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#ifndef DELIMITERSCANNER_H
+#define DELIMITERSCANNER_H
+
+#include <QtGlobal>
+
+class DelimiterScanner {
+public:
+    /**
+     * Implementations of `scan`, from slowest to fastest
+     */
+    enum Kernel {
+        Scalar,
+        Sse2,
+        Avx2
+    };
+
+    /**
+     * Finds every delimiter in [data, data + length) and marks it in a bitmap,
+     * where bit i % 64 of word i / 64 stands for data[i]
+     *
+     * Both bitmaps need room for (length + 63) / 64 words, and bits past the end are cleared.
+     *
+     * @param data the bytes to scan
+     * @param length the number of bytes
+     * @param newlines the bits of LF bytes are set here
+     * @param separators the bits of comma, space and tab bytes are set here
+     */
+    static void scan(const char* data, const int length, quint64* newlines, quint64* separators);
+
+    /**
+     * @return the fastest kernel this CPU runs, picked when the program starts
+     */
+    static Kernel bestKernel();
+
+    /**
+     * @return whether the given kernel was built in and runs on this CPU
+     */
+    static bool isSupported(const Kernel kernel);
+
+    /**
+     * @return the kernel used by `scan`
+     */
+    static Kernel kernel();
+
+    /**
+     * Makes `scan` use another kernel, for comparing them in tests and benchmarks
+     *
+     * Not thread safe, only call it while no input is being parsed.
+     *
+     * @param kernel a supported kernel
+     */
+    static void setKernel(const Kernel kernel);
+};
+
+#endif // DELIMITERSCANNER_H
@@ -0,0 +1,198 @@
+/**
+ * @file framedecoder.cpp
+ * @brief Implementation of FrameDecoder class
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#include "framedecoder.h"
+#include <QtEndian>
+#include <cstring>
+
+// the largest valid frame is 2 + 255 * 4 + 2 bytes, plus COBS overhead
+#define MAXFRAMELENGTH 1100
+
+#define COBS_END '\x00'
+#define SLIP_END '\xC0'
+#define SLIP_ESC '\xDB'
+#define SLIP_ESC_END '\xDC'
+#define SLIP_ESC_ESC '\xDD'
+
+FrameDecoder::FrameDecoder(const Framing framing) :
+    m_framing(framing),
+    m_escaped(false),
+    m_discarding(false),
+    m_errorCount(0) {
+    m_frame.reserve(MAXFRAMELENGTH);
+    m_decoded.reserve(MAXFRAMELENGTH);
+}
+
+void FrameDecoder::setFraming(const Framing framing) {
+    m_framing = framing;
+    reset();
+}
+
+void FrameDecoder::reset() {
+    m_frame.resize(0);
+    m_escaped = false;
+    m_discarding = false;
+}
+
+void FrameDecoder::feed(const QByteArray& buf, QVector<qreal>& values, QVector<int>& rowEnds,
+                        QVector<int>* rowOffsets) {
+    const char* pos = buf.constData();
+    const char* const end = pos + buf.size();
+    if (m_framing == Cobs) {
+        // COBS frames contain no zero bytes, so they can be copied in whole chunks
+        while (pos < end) {
+            const char* delimiter = static_cast<const char*>(memchr(pos, COBS_END, end - pos));
+            const char* chunkEnd = delimiter != nullptr ? delimiter : end;
+            if (!m_discarding) {
+                if (m_frame.size() + (chunkEnd - pos) > MAXFRAMELENGTH) {
+                    m_discarding = true;
+                } else {
+                    m_frame.append(pos, int(chunkEnd - pos));
+                }
+            }
+            if (delimiter == nullptr) return;
+            pos = delimiter + 1;
+            if (endFrame(values, rowEnds) && rowOffsets != nullptr) {
+                *rowOffsets << int(pos - buf.constData());
+            }
+        }
+        return;
+    }
+    for (; pos < end; ++pos) {
+        const char c = *pos;
+        if (c == SLIP_END) {
+            if (endFrame(values, rowEnds) && rowOffsets != nullptr) {
+                *rowOffsets << int(pos + 1 - buf.constData());
+            }
+            continue;
+        }
+        if (m_discarding) continue;
+        char decoded = c;
+        if (m_escaped) {
+            m_escaped = false;
+            if (c == SLIP_ESC_END) {
+                decoded = SLIP_END;
+            } else if (c == SLIP_ESC_ESC) {
+                decoded = SLIP_ESC;
+            } else {
+                m_discarding = true;
+                continue;
+            }
+        } else if (c == SLIP_ESC) {
+            m_escaped = true;
+            continue;
+        }
+        if (m_frame.size() >= MAXFRAMELENGTH) {
+            m_discarding = true;
+            continue;
+        }
+        m_frame.append(decoded);
+    }
+}
+
+quint16 FrameDecoder::crc16(const char* data, const int length) {
+    quint16 crc = 0xFFFF;
+    for (int i = 0; i < length; ++i) {
+        crc ^= quint16(quint8(data[i])) << 8;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x8000) ? quint16((crc << 1) ^ 0x1021) : quint16(crc << 1);
+        }
+    }
+    return crc;
+}
+
+bool FrameDecoder::endFrame(QVector<qreal>& values, QVector<int>& rowEnds) {
+    const bool discarded = m_discarding || m_escaped;
+    const bool empty = m_frame.isEmpty();
+    bool valid = false;
+    bool appended = false;
+    if (!discarded && !empty) {
+        const int rowStart = values.size();
+        if (m_framing == Cobs) {
+            valid = decodeCobs() && decodePayload(m_decoded, values);
+        } else {
+            valid = decodePayload(m_frame, values);
+        }
+        if (valid && values.size() > rowStart) {
+            rowEnds << values.size();
+            appended = true;
+        }
+    }
+    // back to back delimiters are allowed between frames and are not an error
+    if (discarded || (!empty && !valid)) {
+        ++m_errorCount;
+    }
+    reset();
+    return appended;
+}
+
+bool FrameDecoder::decodeCobs() {
+    m_decoded.resize(0);
+    const char* p = m_frame.constData();
+    const char* const end = p + m_frame.size();
+    while (p < end) {
+        const int code = quint8(*p++);
+        // a code byte of n is followed by n - 1 data bytes
+        if (code == 0 || end - p < code - 1) return false;
+        m_decoded.append(p, code - 1);
+        p += code - 1;
+        // every block but a full one implies a zero, except at the end of the frame
+        if (code < 0xFF && p < end) {
+            m_decoded.append('\0');
+        }
+    }
+    return true;
+}
+
+bool FrameDecoder::decodePayload(const QByteArray& payload, QVector<qreal>& values) {
+    if (payload.size() < 4) return false;
+    const char* data = payload.constData();
+    const int type = quint8(data[0]);
+    const int count = quint8(data[1]);
+    int valueSize;
+    switch (type) {
+    case Int16:
+        valueSize = 2;
+        break;
+    case Int32:
+    case Float32:
+        valueSize = 4;
+        break;
+    default:
+        return false;
+    }
+    if (payload.size() != 2 + count * valueSize + 2) return false;
+    const int checked = payload.size() - 2;
+    if (qFromLittleEndian<quint16>(data + checked) != crc16(data, checked)) return false;
+
+    const int rowStart = values.size();
+    const char* p = data + 2;
+    for (int i = 0; i < count; ++i, p += valueSize) {
+        switch (type) {
+        case Int16:
+            values << qFromLittleEndian<qint16>(p);
+            break;
+        case Int32:
+            values << qFromLittleEndian<qint32>(p);
+            break;
+        default: {
+            const quint32 bits = qFromLittleEndian<quint32>(p);
+            float value;
+            memcpy(&value, &bits, sizeof(value));
+            // infinities and NaN can't be placed on an axis
+            if (!qIsFinite(value)) {
+                values.resize(rowStart);
+                return false;
+            }
+            values << value;
+        }
+        }
+    }
+    return true;
+}
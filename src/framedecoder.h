@@ -0,0 +1,144 @@
+/**
+ * @file framedecoder.h
+ * @brief Decoder for binary telemetry frames delimited with COBS or SLIP
+ *
+ * Every frame carries one row of values:
+ *
+ *     type (1 byte) | count (1 byte) | count values | CRC (2 bytes)
+ *
+ * where type is 0 for int16, 1 for int32 and 2 for float32 values, all values
+ * and the CRC are little-endian, and the CRC is CRC-16/CCITT-FALSE over
+ * everything before it. The frame is then COBS encoded and followed by a 0x00,
+ * or SLIP encoded and followed by 0xC0.
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#ifndef FRAMEDECODER_H
+#define FRAMEDECODER_H
+
+#include <QByteArray>
+#include <QVector>
+
+class FrameDecoder {
+public:
+    /**
+     * How frames are delimited in the byte stream
+     */
+    enum Framing {
+        Cobs,
+        Slip
+    };
+
+    /**
+     * Type of the values in a frame, stored in its first byte
+     */
+    enum ValueType {
+        Int16 = 0,
+        Int32 = 1,
+        Float32 = 2
+    };
+
+    /**
+     * Constructs a decoder waiting for the start of a frame
+     *
+     * @param framing how frames are delimited
+     */
+    explicit FrameDecoder(const Framing framing = Cobs);
+
+    /**
+     * Changes how frames are delimited, dropping any partial frame
+     *
+     * @param framing how frames are delimited
+     */
+    void setFraming(const Framing framing);
+
+    /**
+     * Decodes all frames completed by the given buffer and appends their values, one row per frame
+     *
+     * A corrupt frame is dropped on its own, decoding resumes with the next delimiter.
+     * A partial frame at the end of the buffer is kept and completed by the next call.
+     *
+     * @param buf the input buffer
+     * @param values the values of all valid frames are appended here
+     * @param rowEnds for every valid frame, the index one past its last value in values is appended here
+     * @param rowOffsets if given, for every valid frame, the offset in buf one past its delimiter is appended here
+     */
+    void feed(const QByteArray& buf, QVector<qreal>& values, QVector<int>& rowEnds,
+              QVector<int>* rowOffsets = nullptr);
+
+    /**
+     * Drops the partial frame left over from the last call to `feed`
+     */
+    void reset();
+
+    /**
+     * @return the number of frames dropped so far because they were corrupt
+     */
+    qint64 errorCount() const { return m_errorCount; }
+
+    /**
+     * Computes the CRC-16/CCITT-FALSE used to check frames
+     *
+     * @param data the bytes to check
+     * @param length the number of bytes
+     * @return the CRC
+     */
+    static quint16 crc16(const char* data, const int length);
+
+private:
+    /**
+     * How frames are delimited
+     */
+    Framing m_framing;
+
+    /**
+     * Bytes of the frame being received, still encoded for COBS and already decoded for SLIP
+     */
+    QByteArray m_frame;
+
+    /**
+     * Scratch space for decoding a COBS frame
+     */
+    QByteArray m_decoded;
+
+    /**
+     * Whether the last SLIP byte was an escape
+     */
+    bool m_escaped;
+
+    /**
+     * Whether the current frame is being skipped until the next delimiter
+     */
+    bool m_discarding;
+
+    /**
+     * The number of frames dropped so far
+     */
+    qint64 m_errorCount;
+
+    /**
+     * Handles the end of a frame, decoding it when it is valid
+     *
+     * @return whether a row was appended
+     */
+    bool endFrame(QVector<qreal>& values, QVector<int>& rowEnds);
+
+    /**
+     * Undoes COBS encoding of `m_frame` into `m_decoded`
+     *
+     * @return whether the encoding was valid
+     */
+    bool decodeCobs();
+
+    /**
+     * Checks the CRC and layout of a decoded frame, and appends its values
+     *
+     * @return whether the frame was valid
+     */
+    static bool decodePayload(const QByteArray& payload, QVector<qreal>& values);
+};
+
+#endif // FRAMEDECODER_H
@@ -0,0 +1,85 @@
+/**
+ * @file headlessstreamer.cpp
+ * @brief Implementation of HeadlessStreamer class
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#include "headlessstreamer.h"
+#include "monotonicclock.h"
+#include <cstdio>
+
+// enough for any double printed with %.15g
+#define MAXNUMBERLENGTH 32
+
+HeadlessStreamer::HeadlessStreamer(QIODevice* out, const bool raw) :
+    m_out(out),
+    m_raw(raw),
+    m_stats(nullptr) {
+
+    m_text.reserve(4096);
+    connect(&m_reader, &PortReader::dataRead, this, &HeadlessStreamer::processData);
+    connect(&m_reader, &PortReader::errorOccurred, this, &HeadlessStreamer::handleError);
+}
+
+void HeadlessStreamer::start(const QString& port, const qint32 baudRate) {
+    m_reader.setPortName(port);
+    m_reader.setBaudRate(baudRate);
+    m_reader.open();
+}
+
+void HeadlessStreamer::setStats(PipelineStats* stats) {
+    m_stats = stats;
+    m_reader.setStats(stats);
+}
+
+void HeadlessStreamer::processData(const QByteArray& buf, const qint64 time) {
+    if (m_stats != nullptr) {
+        m_stats->addBytesProcessed(buf.size());
+    }
+    if (m_raw) {
+        if (m_out->write(buf) != buf.size()) {
+            emit failed(m_out->errorString());
+        }
+        trackLatency(time);
+        return;
+    }
+    // the buffers keep their capacity, so a steady stream allocates nothing
+    m_values.resize(0);
+    m_rowEnds.resize(0);
+    m_text.resize(0);
+    const qint64 rejected = m_parser.rejectedCount();
+    m_parser.feed(buf, m_values, m_rowEnds);
+    if (m_stats != nullptr) {
+        m_stats->addRows(m_rowEnds.size(), m_parser.rejectedCount() - rejected);
+    }
+    if (m_rowEnds.isEmpty()) return;
+
+    char number[MAXNUMBERLENGTH];
+    int rowStart = 0;
+    for (const int rowEnd : m_rowEnds) {
+        for (int i = rowStart; i < rowEnd; ++i) {
+            const int length = snprintf(number, sizeof(number), "%.15g", m_values[i]);
+            m_text.append(number, length);
+            m_text.append(i + 1 < rowEnd ? ',' : '\n');
+        }
+        rowStart = rowEnd;
+    }
+    // one write per input buffer, the device is expected to be unbuffered
+    if (m_out->write(m_text) != m_text.size()) {
+        emit failed(m_out->errorString());
+    }
+    trackLatency(time);
+}
+
+inline void HeadlessStreamer::trackLatency(const qint64 time) {
+    if (m_stats != nullptr && time >= 0) {
+        m_stats->addLatency(MonotonicClock::now() - time);
+    }
+}
+
+void HeadlessStreamer::handleError(QSerialPort::SerialPortError err) {
+    emit failed(QString("Serial port error %1: %2").arg(err).arg(m_reader.errorString()));
+}
@@ -0,0 +1,123 @@
+/**
+ * @file headlessstreamer.h
+ * @brief HeadlessStreamer class for streaming port input without a GUI
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#ifndef HEADLESSSTREAMER_H
+#define HEADLESSSTREAMER_H
+
+#include <QObject>
+#include <QIODevice>
+#include "lineparser.h"
+#include "portreader.h"
+
+class HeadlessStreamer : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * Constructs a streamer writing to the given device
+     *
+     * Everything, including the serial port, runs in the thread the streamer lives in
+     *
+     * @param out the device to write to, must be open and outlive the streamer
+     * @param raw whether to write the input as is instead of parsed rows as CSV
+     */
+    HeadlessStreamer(QIODevice* out, const bool raw);
+
+    /**
+     * Sets the counters the streamer and its reader add to, with the latency from reading to writing
+     *
+     * @param stats the counters, or nullptr to count nothing
+     */
+    void setStats(PipelineStats* stats);
+
+signals:
+    /**
+     * Emitted when the port can't be read or the output can't be written
+     *
+     * @param message description of the error
+     */
+    void failed(const QString& message);
+
+public slots:
+    /**
+     * Opens the port and starts streaming
+     *
+     * @param port the name of the port
+     * @param baudRate the baud rate
+     */
+    void start(const QString& port, const qint32 baudRate);
+
+    /**
+     * Writes one buffer of input, either as is, or as one CSV line per parsed row
+     *
+     * Numbers are formatted with the C library, so LC_NUMERIC should be "C"
+     *
+     * @param buf the input buffer
+     * @param time when the buffer was read in ns of MonotonicClock, or -1 for now
+     */
+    void processData(const QByteArray& buf, const qint64 time = -1);
+
+private slots:
+    /**
+     * Reports serial port errors through `failed`
+     *
+     * @param err the error enum which corresponds to the error
+     */
+    void handleError(QSerialPort::SerialPortError err);
+
+private:
+    /**
+     * Reads the port in this thread
+     */
+    PortReader m_reader;
+
+    /**
+     * The same parser the worker uses for the plotter
+     */
+    LineParser m_parser;
+
+    /**
+     * Where the output goes
+     */
+    QIODevice* m_out;
+
+    /**
+     * Whether the input is written as is
+     */
+    bool m_raw;
+
+    /**
+     * Counters of the pipeline, not owned by the streamer
+     */
+    PipelineStats* m_stats;
+
+    /**
+     * Values parsed from the current buffer
+     */
+    QVector<qreal> m_values;
+
+    /**
+     * Row ends in `m_values`
+     */
+    QVector<int> m_rowEnds;
+
+    /**
+     * CSV text for the current buffer, written out at once
+     */
+    QByteArray m_text;
+
+    /**
+     * Counts the time from reading a buffer until it was written out
+     *
+     * @param time when the buffer was read, or -1 when unknown
+     */
+    inline void trackLatency(const qint64 time);
+};
+
+#endif // HEADLESSSTREAMER_H
@@ -0,0 +1,110 @@
+/**
+ * @file hexview.cpp
+ * @brief Implementation of HexView class
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#include "hexview.h"
+#include <QPainter>
+#include <QScrollBar>
+#include <climits>
+#include <cstring>
+
+#define BYTESPERROW 16
+#define DEFAULTROWS 10000
+// hex digits of the offset, more are shown once the stream is longer than that
+#define OFFSETDIGITS 8
+// columns of the hex bytes and of the ASCII in bars, counted from the end of the offset
+#define HEXCOLUMN 2
+#define ASCIICOLUMN (HEXCOLUMN + BYTESPERROW * 3 + 2)
+#define ROWTAILLENGTH (ASCIICOLUMN + BYTESPERROW + 2)
+
+namespace {
+
+const char hexDigits[] = "0123456789abcdef";
+
+}
+
+HexView::HexView(QWidget* parent) :
+    RowView(parent),
+    m_bytes(DEFAULTROWS * BYTESPERROW) {
+    updateScrollBars();
+}
+
+void HexView::setMaximumRowCount(const int rows) {
+    const qint64 firstRow = m_bytes.startOffset() / BYTESPERROW;
+    m_bytes.setCapacity(qBound(1, rows, INT_MAX / BYTESPERROW) * BYTESPERROW);
+    updateScrollBars(int(m_bytes.startOffset() / BYTESPERROW - firstRow));
+    viewport()->update();
+}
+
+int HexView::rowCount() const {
+    if (m_bytes.size() == 0) return 0;
+    return int((m_bytes.endOffset() + BYTESPERROW - 1) / BYTESPERROW - m_bytes.startOffset() / BYTESPERROW);
+}
+
+QString HexView::formatRow(const qint64 offset, const char* data, const int begin, const int end) {
+    char row[ROWTAILLENGTH];
+    memset(row, ' ', sizeof(row));
+    char* const ascii = row + ASCIICOLUMN;
+    ascii[0] = '|';
+    ascii[BYTESPERROW + 1] = '|';
+    for (int i = begin; i < end; ++i) {
+        const quint8 byte = quint8(data[i]);
+        // an extra space between the two halves of the row
+        char* const hex = row + HEXCOLUMN + i * 3 + (i >= BYTESPERROW / 2 ? 1 : 0);
+        hex[0] = hexDigits[byte >> 4];
+        hex[1] = hexDigits[byte & 0xF];
+        ascii[1 + i] = byte >= 0x20 && byte < 0x7F ? char(byte) : '.';
+    }
+    return QString::number(offset, 16).rightJustified(OFFSETDIGITS, '0') + QLatin1String(row, sizeof(row));
+}
+
+void HexView::append(const QByteArray& buf) {
+    const qint64 firstRow = m_bytes.startOffset() / BYTESPERROW;
+    m_bytes.append(buf.constData(), buf.size());
+    updateScrollBars(int(m_bytes.startOffset() / BYTESPERROW - firstRow));
+    viewport()->update();
+}
+
+void HexView::clear() {
+    m_bytes.clear();
+    updateScrollBars();
+    viewport()->update();
+}
+
+qint64 HexView::rowLength() const {
+    return OFFSETDIGITS + ROWTAILLENGTH;
+}
+
+QString HexView::rowText(const int row) const {
+    const qint64 offset = (m_bytes.startOffset() / BYTESPERROW + row) * BYTESPERROW;
+    char data[BYTESPERROW];
+    // the oldest and the newest row may be partly outside the kept bytes
+    const int begin = int(qMax(offset, m_bytes.startOffset()) - offset);
+    const int end = int(qMin(offset + BYTESPERROW, m_bytes.endOffset()) - offset);
+    m_bytes.copy(offset + begin, end - begin, data + begin);
+    return formatRow(offset, data, begin, end);
+}
+
+void HexView::paintEvent(QPaintEvent*) {
+    QPainter painter(viewport());
+    painter.setFont(font());
+    const QFontMetrics metrics = fontMetrics();
+    const int lineHeight = metrics.height();
+    const int x = rowX();
+    const int firstRow = verticalScrollBar()->value();
+    // only the rows in view are ever formatted
+    for (int i = 0; i * lineHeight < viewport()->height() && firstRow + i < rowCount(); ++i) {
+        if (isRowSelected(firstRow + i)) {
+            painter.fillRect(0, i * lineHeight, viewport()->width(), lineHeight, palette().highlight());
+            painter.setPen(palette().highlightedText().color());
+        } else {
+            painter.setPen(palette().text().color());
+        }
+        painter.drawText(x, i * lineHeight + metrics.ascent(), rowText(firstRow + i));
+    }
+}
@@ -0,0 +1,83 @@
+/**
+ * @file hexview.h
+ * @brief Monitor view showing the input as a hex dump with offset, hex and ASCII columns
+ *
+ * Only the rows in the viewport are formatted when it is painted, so the cost of
+ * appending and scrolling doesn't depend on how much input is kept.
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#ifndef HEXVIEW_H
+#define HEXVIEW_H
+
+#include "bytering.h"
+#include "rowview.h"
+
+class HexView : public RowView
+{
+    Q_OBJECT
+public:
+    /**
+     * Constructs an empty view
+     *
+     * @param parent the parent widget
+     */
+    explicit HexView(QWidget* parent = nullptr);
+
+    /**
+     * Changes how many rows of input are kept, dropping the oldest ones first
+     *
+     * @param rows the number of rows of 16 bytes
+     */
+    void setMaximumRowCount(const int rows);
+
+    /**
+     * @return the bytes kept by the view
+     */
+    const ByteRing& bytes() const { return m_bytes; }
+
+    /**
+     * @return the number of rows the kept bytes span
+     */
+    int rowCount() const override;
+
+    /**
+     * Formats one row of the dump, like `0000a0f0  31 2c 32 0d 0a ...  |1,2..|`
+     *
+     * @param offset the offset in the stream of the row, a multiple of 16
+     * @param data the 16 bytes of the row
+     * @param begin the first byte of the row that is shown
+     * @param end one past the last byte of the row that is shown
+     * @return the row, of the same length whichever bytes are shown
+     */
+    static QString formatRow(const qint64 offset, const char* data, const int begin, const int end);
+
+public slots:
+    /**
+     * Appends input to the end of the dump, keeping the rows in view unless they were dropped
+     *
+     * @param buf the input
+     */
+    void append(const QByteArray& buf);
+
+    /**
+     * Removes all input, later input keeps its offset in the stream
+     */
+    void clear();
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    qint64 rowLength() const override;
+    QString rowText(const int row) const override;
+
+private:
+    /**
+     * The newest bytes of the input
+     */
+    ByteRing m_bytes;
+};
+
+#endif // HEXVIEW_H
@@ -0,0 +1,323 @@
+/**
+ * @file lineparser.cpp
+ * @brief Implementation of LineParser class
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#include "lineparser.h"
+#include "delimiterscanner.h"
+#include <QtAlgorithms>
+#include <QtNumeric>
+
+// lines longer than this are dropped instead of buffering them forever
+#define MAXLINELENGTH 65536
+// more significant digits than this may not fit in the mantissa
+#define MAXMANTISSADIGITS 19
+// every integer up to 2^53 is exactly representable as a double
+#define MAXEXACTINTEGER (quint64(1) << 53)
+// larger exponents overflow or underflow any double
+#define MAXEXPONENT 100000
+// longer words before a = or : are not taken as the names of fields
+#define MAXNAMELENGTH 64
+
+namespace {
+
+// every power of ten up to 10^22 is exactly representable as a double
+const double powersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+inline bool isDigit(const char c) {
+    return c >= '0' && c <= '9';
+}
+
+inline bool isNameStart(const char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+inline bool isNameChar(const char c) {
+    return isNameStart(c) || isDigit(c) || c == '.';
+}
+
+/**
+ * Returns the = or : ending the name of a field at the start of [begin, end),
+ * like `temp=21.5`, or nullptr if there is none
+ */
+inline const char* fieldSeparator(const char* begin, const char* end) {
+    if (begin == end || !isNameStart(*begin)) return nullptr;
+    const char* p = begin + 1;
+    while (p < end && isNameChar(*p)) ++p;
+    if (p == end || (*p != '=' && *p != ':') || p - begin > MAXNAMELENGTH) return nullptr;
+    return p;
+}
+
+inline bool testBit(const quint64* bits, const int i) {
+    return (bits[i / 64] >> (i % 64)) & 1;
+}
+
+/**
+ * Returns the position of the first set bit in [from, to), or to if there is none
+ */
+inline int nextSetBit(const quint64* bits, int from, const int to) {
+    while (from < to) {
+        const quint64 word = bits[from / 64] >> (from % 64);
+        if (word != 0) return qMin(from + int(qCountTrailingZeroBits(word)), to);
+        from = (from / 64 + 1) * 64;
+    }
+    return to;
+}
+
+/**
+ * Returns the start of the longest suffix of [begin, end) that is a number,
+ * or end if there is none
+ */
+const char* numberSuffix(const char* begin, const char* end) {
+    const char* p = end;
+    while (p > begin && isDigit(p[-1])) --p;
+    if (p == end) return end;
+    // an exponent needs at least one digit right before its e
+    const char* exponent = p;
+    if (exponent > begin && (exponent[-1] == '+' || exponent[-1] == '-')) --exponent;
+    if (exponent - begin >= 2 && (exponent[-1] == 'e' || exponent[-1] == 'E') && isDigit(exponent[-2])) {
+        p = exponent - 1;
+        while (p > begin && isDigit(p[-1])) --p;
+    }
+    // a fraction needs at least one digit on both sides of the point
+    if (p - begin >= 2 && p[-1] == '.' && isDigit(p[-2])) {
+        --p;
+        while (p > begin && isDigit(p[-1])) --p;
+    }
+    if (p > begin && p[-1] == '-') --p;
+    return p;
+}
+
+}
+
+LineParser::LineParser() :
+    m_discarding(false),
+    m_rejectedCount(0) {
+    // reserving keeps the capacity around when the leftover is emptied
+    m_leftover.reserve(256);
+}
+
+void LineParser::reset() {
+    m_leftover.resize(0);
+    m_discarding = false;
+}
+
+void LineParser::feed(const QByteArray& buf, QVector<qreal>& values, QVector<int>& rowEnds,
+                      QVector<int>* rowOffsets, QVector<int>* channels) {
+    const char* const data = buf.constData();
+    const int size = buf.size();
+    // one pass classifies every delimiter in the buffer, lines and tokens are then found from the bitmaps
+    const int words = (size + 63) / 64;
+    m_newlines.resize(words);
+    m_separators.resize(words);
+    DelimiterScanner::scan(data, size, m_newlines.data(), m_separators.data());
+    int pos = 0;
+    for (int word = 0; word < words; ++word) {
+        for (quint64 bits = m_newlines[word]; bits != 0; bits &= bits - 1) {
+            const int newline = word * 64 + int(qCountTrailingZeroBits(bits));
+            bool accepted;
+            if (m_discarding) {
+                m_discarding = false;
+                accepted = false;
+            } else if (m_leftover.isEmpty()) {
+                // the whole line is in this buffer, so parse it in place
+                accepted = parseLine(data + pos, data + newline, m_separators.constData(), pos, values, channels);
+            } else {
+                // the line was broken up into separate packets
+                m_leftover.append(data + pos, newline - pos);
+                const int lineWords = (m_leftover.size() + 63) / 64;
+                m_lineNewlines.resize(lineWords);
+                m_lineSeparators.resize(lineWords);
+                DelimiterScanner::scan(m_leftover.constData(), m_leftover.size(),
+                                       m_lineNewlines.data(), m_lineSeparators.data());
+                accepted = parseLine(m_leftover.constData(), m_leftover.constData() + m_leftover.size(),
+                                     m_lineSeparators.constData(), 0, values, channels);
+                m_leftover.resize(0);
+            }
+            if (accepted) {
+                rowEnds << values.size();
+                if (rowOffsets != nullptr) {
+                    *rowOffsets << newline + 1;
+                }
+            } else {
+                ++m_rejectedCount;
+            }
+            pos = newline + 1;
+        }
+    }
+    if (pos < size) {
+        keepLeftover(data + pos, data + size);
+    }
+}
+
+inline void LineParser::keepLeftover(const char* begin, const char* end) {
+    if (m_discarding) return;
+    if (m_leftover.size() + (end - begin) > MAXLINELENGTH) {
+        m_leftover.resize(0);
+        m_discarding = true;
+        return;
+    }
+    m_leftover.append(begin, int(end - begin));
+}
+
+bool LineParser::parseLine(const char* begin, const char* end, const quint64* separators, const int firstBit,
+                           QVector<qreal>& values, QVector<int>* channels) {
+    const int rowStart = values.size();
+    if (end > begin && end[-1] == '\r') --end;
+    const int length = int(end - begin);
+    // the line must end with a number
+    if (length == 0 || testBit(separators, firstBit + length - 1)) return false;
+
+    m_rowChannels.resize(0);
+    m_rowValues.resize(0);
+    for (int tokenStart = 0; tokenStart <= length;) {
+        const int tokenEnd = nextSetBit(separators, firstBit + tokenStart, firstBit + length) - firstBit;
+        if (tokenEnd != tokenStart) {
+            const char* token = begin + tokenStart;
+            const char* p = begin + tokenEnd;
+            const char* separator = fieldSeparator(token, p);
+            qreal number;
+            if (separator != nullptr && separator + 1 < p && toNumber(separator + 1, p, number)) {
+                addField(token, int(separator - token), number);
+            } else if (toNumber(token, p, number)) {
+                values << number;
+            } else {
+                // nothing before an invalid token can be part of the list, like the label `ADC:` in
+                // `ADC: 512 300`, but the list may still start at a number at the end of the token
+                values.resize(rowStart);
+                const char* suffix = numberSuffix(token, p);
+                if (suffix != p && toNumber(suffix, p, number)) {
+                    values << number;
+                }
+            }
+        }
+        tokenStart = tokenEnd + 1;
+    }
+    // the list comes first, so its numbers keep their positions
+    const int listEnd = values.size();
+    values += m_rowValues;
+    if (values.size() == rowStart) return false;
+    if (channels != nullptr) {
+        if (!m_rowChannels.isEmpty()) {
+            // the lines before and the list were all without names
+            while (channels->size() < listEnd) {
+                *channels << -1;
+            }
+            *channels += m_rowChannels;
+        } else if (!channels->isEmpty()) {
+            while (channels->size() < values.size()) {
+                *channels << -1;
+            }
+        }
+    }
+    return true;
+}
+
+inline void LineParser::addField(const char* name, const int nameLength, const qreal number) {
+    const int channel = m_channels.intern(name, nameLength);
+    // the table is full
+    if (channel < 0) return;
+    // lines only have a handful of fields
+    if (m_rowChannels.contains(channel)) return;
+    m_rowChannels << channel;
+    m_rowValues << number;
+}
+
+bool LineParser::toNumber(const char* begin, const char* end, qreal& number) {
+    const char* p = begin;
+    const bool negative = *p == '-';
+    if (negative) ++p;
+    quint64 mantissa = 0;
+    int digits = 0;
+    // the number is mantissa * 10^exponent, unless digits had to be dropped
+    int exponent = 0;
+    bool truncated = false;
+    const char* integer = p;
+    for (; p < end && isDigit(*p); ++p) {
+        if (digits < MAXMANTISSADIGITS) {
+            mantissa = mantissa * 10 + quint64(*p - '0');
+            // leading zeros don't take up room in the mantissa
+            if (mantissa != 0) ++digits;
+        } else {
+            ++exponent;
+            truncated = truncated || *p != '0';
+        }
+    }
+    if (p == integer) return false;
+    if (p == end && exponent == 0) {
+        // most columns are counts, and converting a 64 bit integer is already correctly rounded
+        number = negative ? -double(mantissa) : double(mantissa);
+        return true;
+    }
+
+    if (p < end && *p == '.') {
+        const char* fraction = ++p;
+        for (; p < end && isDigit(*p); ++p) {
+            if (digits < MAXMANTISSADIGITS) {
+                mantissa = mantissa * 10 + quint64(*p - '0');
+                if (mantissa != 0) ++digits;
+                --exponent;
+            } else {
+                truncated = truncated || *p != '0';
+            }
+        }
+        if (p == fraction) return false;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        const bool negativeExponent = p < end && *p == '-';
+        if (p < end && (*p == '+' || *p == '-')) ++p;
+        const char* exponentDigits = p;
+        int explicitExponent = 0;
+        for (; p < end && isDigit(*p); ++p) {
+            // anything this large is out of range either way
+            if (explicitExponent < MAXEXPONENT) {
+                explicitExponent = explicitExponent * 10 + (*p - '0');
+            }
+        }
+        if (p == exponentDigits) return false;
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+    if (p != end) return false;
+
+    if (!truncated && mantissa <= MAXEXACTINTEGER) {
+        // both the mantissa and the power of ten are exact here,
+        // so a single multiplication or division is correctly rounded
+        double value = double(mantissa);
+        if (mantissa == 0 || exponent == 0) {
+            number = negative ? -value : value;
+            return true;
+        }
+        if (exponent < 0 && exponent >= -22) {
+            value /= powersOfTen[-exponent];
+            number = negative ? -value : value;
+            return true;
+        }
+        if (exponent > 0 && exponent <= 22 + 15) {
+            // a large exponent can still be exact when part of it fits in the mantissa
+            if (exponent > 22) {
+                value *= powersOfTen[exponent - 22];
+                exponent = 22;
+            }
+            if (value < double(MAXEXACTINTEGER)) {
+                value *= powersOfTen[exponent];
+                number = negative ? -value : value;
+                return true;
+            }
+        }
+    }
+    // rare case of very long or very large numbers, fall back to Qt's conversion
+    bool ok;
+    const double value = QByteArray(begin, int(end - begin)).toDouble(&ok);
+    // infinities can't be placed on an axis
+    if (!ok || !qIsFinite(value)) return false;
+    number = value;
+    return true;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file lineparser.h
+ * @brief Byte-level scanner that extracts rows of numbers from the serial input
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#ifndef LINEPARSER_H
+#define LINEPARSER_H
+
+#include <QByteArray>
+#include <QVector>
+#include "channeltable.h"
+
+class LineParser {
+public:
+    /**
+     * Default constructor, takes no arguments
+     */
+    LineParser();
+
+    /**
+     * Scans the given buffer for complete lines and appends the numbers of every accepted line
+     *
+     * A line is accepted when it ends in a comma/tab/space separated list of decimal numbers,
+     * optionally in exponent notation like 1.5e-3, followed by either CRLF or LF,
+     * and only that trailing list is taken from the line.
+     * Named fields like `temp=21.5,volt:3.3` may be anywhere in the line without breaking up the list,
+     * and are taken after it, each name once. A name only counts with its value right after it, so in
+     * `temp: 21.5` or `ADC: 512 300` the word before the numbers is a label, and the numbers are the list.
+     * A partial line at the end of the buffer is kept and completed by the next call.
+     *
+     * @param buf the input buffer
+     * @param values the numbers of all accepted lines are appended here
+     * @param rowEnds for every accepted line, the index one past its last number in values is appended here
+     * @param rowOffsets if given, for every accepted line, the offset in buf one past its LF is appended here
+     * @param channels if given, left alone until a line with named fields is accepted, from then on kept
+     *                 the same size as values with the id in `channelNames()` of every number, or -1 for
+     *                 a number of the list
+     */
+    void feed(const QByteArray& buf, QVector<qreal>& values, QVector<int>& rowEnds,
+              QVector<int>* rowOffsets = nullptr, QVector<int>* channels = nullptr);
+
+    /**
+     * Drops the partial line left over from the last call to `feed`
+     */
+    void reset();
+
+    /**
+     * @return the number of complete lines so far that weren't accepted
+     */
+    qint64 rejectedCount() const { return m_rejectedCount; }
+
+    /**
+     * @return the names of the named channels by id, implicitly shared
+     */
+    const QStringList& channelNames() const { return m_channels.names(); }
+
+private:
+    /**
+     * Raw bytes of the partial line left over from the last call to `feed`
+     */
+    QByteArray m_leftover;
+
+    /**
+     * Whether the rest of the current line is being skipped because it was too long
+     */
+    bool m_discarding;
+
+    /**
+     * The number of lines not accepted so far
+     */
+    qint64 m_rejectedCount;
+
+    /**
+     * Bitmaps of the LF and separator bytes in the buffer being fed
+     */
+    QVector<quint64> m_newlines;
+    QVector<quint64> m_separators;
+
+    /**
+     * Bitmaps of the LF and separator bytes in a line put together from the leftover
+     */
+    QVector<quint64> m_lineNewlines;
+    QVector<quint64> m_lineSeparators;
+
+    /**
+     * The names of the named channels seen so far
+     */
+    ChannelTable m_channels;
+
+    /**
+     * Channels and values of the named fields of the line being parsed
+     */
+    QVector<int> m_rowChannels;
+    QVector<qreal> m_rowValues;
+
+    /**
+     * Keeps the bytes in [begin, end) as the start of the next line
+     */
+    inline void keepLeftover(const char* begin, const char* end);
+
+    /**
+     * Parses the line [begin, end), excluding the LF, and appends its numbers to values
+     *
+     * @param separators bitmap of the separator bytes from `DelimiterScanner`
+     * @param firstBit the bit in separators that stands for begin
+     * @param channels as in `feed`
+     * @return whether the line was accepted
+     */
+    bool parseLine(const char* begin, const char* end, const quint64* separators, const int firstBit,
+                   QVector<qreal>& values, QVector<int>* channels);
+
+    /**
+     * Adds a named field to the line being parsed, unless the line already has one of that name
+     *
+     * @param name the name of the field
+     * @param nameLength the number of bytes of the name
+     * @param number the value of the field
+     */
+    inline void addField(const char* name, const int nameLength, const qreal number);
+
+    /**
+     * Converts a token of the form -?\d+(\.\d+)?([eE][+-]?\d+)? to a correctly rounded qreal,
+     * without any allocation unless it has more than 19 significant digits or a huge exponent
+     *
+     * @param number set to the value of the token when it is valid
+     * @return whether the token is a valid finite number
+     */
+    static bool toNumber(const char* begin, const char* end, qreal& number);
+};
+
+#endif // LINEPARSER_H
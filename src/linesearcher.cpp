@@ -0,0 +1,114 @@
+/**
+ * @file linesearcher.cpp
+ * @brief Implementation of LineSearcher class
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#include "linesearcher.h"
+
+// bytes of lines scanned at a time, the window may have to wait this long to append
+#define SEARCHCHUNKBYTES (256 * 1024)
+
+LineSearcher::LineSearcher(const LineStore* lines, QReadWriteLock* lock) :
+    m_lines(lines),
+    m_lock(lock),
+    m_generation(0),
+    m_active(false),
+    m_regex(false),
+    m_nextLine(0) {
+    qRegisterMetaType<QVector<qint64>>("QVector<qint64>");
+}
+
+void LineSearcher::setPattern(const int generation, const QString& pattern, const bool regex) {
+    m_generation = generation;
+    m_regex = regex;
+    if (regex) {
+        m_expression.setPattern(pattern);
+        m_expression.optimize();
+        m_active = !pattern.isEmpty() && m_expression.isValid();
+    } else {
+        m_matcher.setPattern(pattern.toUtf8());
+        // no line can contain a newline
+        m_active = !pattern.isEmpty() && !pattern.contains('\n');
+    }
+    m_nextLine = 0;
+    scan();
+}
+
+void LineSearcher::scan() {
+    if (!m_active) return;
+    QVector<qint64> matches;
+    bool more;
+    {
+        QReadLocker locker(m_lock);
+        const qint64 firstLine = m_lines->droppedLineCount();
+        const int begin = int(qMax(m_nextLine, firstLine) - firstLine);
+        // the last line may still grow, so it is left until it is finished
+        const int finished = m_lines->finishedLineCount();
+        int end = begin;
+        for (int bytes = 0; end < finished && bytes < SEARCHCHUNKBYTES; ++end) {
+            bytes += m_lines->lineLength(end) + 1;
+        }
+        if (begin == end) return;
+        if (m_regex) {
+            matchExpression(begin, end, matches);
+        } else {
+            matchSubstring(begin, end, matches);
+        }
+        for (qint64& line : matches) {
+            line += firstLine;
+        }
+        m_nextLine = firstLine + end;
+        more = end < finished;
+    }
+    if (!matches.isEmpty()) {
+        emit matchesFound(m_generation, matches);
+    }
+    // the rest comes after anything queued meanwhile, like a new pattern
+    if (more) {
+        QMetaObject::invokeMethod(this, "scan", Qt::QueuedConnection);
+    }
+}
+
+void LineSearcher::matchSubstring(const int begin, const int end, QVector<qint64>& matches) const {
+    // the lines are back to back, so all of them are searched at once
+    const char* const data = m_lines->lineData(begin);
+    const int length = int(m_lines->lineData(end - 1) + m_lines->lineLength(end - 1) - data);
+    int line = begin;
+    int from = 0;
+    while (line < end) {
+        const int found = m_matcher.indexIn(data, length, from);
+        if (found < 0) break;
+        while (line + 1 < end && m_lines->lineData(line + 1) <= data + found) {
+            ++line;
+        }
+        // matched as shown, so not into the carriage return of a "\r\n" ending
+        const char* const lineData = m_lines->lineData(line);
+        int lineLength = m_lines->lineLength(line);
+        if (lineLength > 0 && lineData[lineLength - 1] == '\r') --lineLength;
+        if (data + found + m_matcher.pattern().size() > lineData + lineLength) {
+            from = found + 1;
+            continue;
+        }
+        matches.append(line);
+        // the rest of a matching line needn't be searched
+        if (++line < end) {
+            from = int(m_lines->lineData(line) - data);
+        }
+    }
+}
+
+void LineSearcher::matchExpression(const int begin, const int end, QVector<qint64>& matches) const {
+    for (int line = begin; line < end; ++line) {
+        const char* data = m_lines->lineData(line);
+        int length = m_lines->lineLength(line);
+        // matched as shown, so `$` matches at the end of lines ending in "\r\n"
+        if (length > 0 && data[length - 1] == '\r') --length;
+        if (m_expression.match(QString::fromUtf8(data, length)).hasMatch()) {
+            matches.append(line);
+        }
+    }
+}
@@ -0,0 +1,121 @@
+/**
+ * @file linesearcher.h
+ * @brief Finds the lines of a LineStore that match a pattern, off the main thread
+ *
+ * The lines are scanned a chunk at a time while holding the store's lock for reading,
+ * so the window is never kept from appending for long. Only lines the searcher hasn't
+ * seen yet are scanned, so new lines are matched as they arrive without scanning the
+ * whole history again.
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#ifndef LINESEARCHER_H
+#define LINESEARCHER_H
+
+#include <QObject>
+#include <QByteArrayMatcher>
+#include <QReadWriteLock>
+#include <QRegularExpression>
+#include <QVector>
+#include "linestore.h"
+
+class LineSearcher : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * Constructs a searcher with no pattern
+     *
+     * @param lines the lines searched, which must outlive the searcher
+     * @param lock held for writing by whoever changes the lines
+     */
+    LineSearcher(const LineStore* lines, QReadWriteLock* lock);
+
+public slots:
+    /**
+     * Starts searching the lines for a new pattern, from the oldest one kept
+     *
+     * @param generation identifies the pattern in `matchesFound`
+     * @param pattern the text to look for, or an empty string to stop searching
+     * @param regex whether the pattern is a regular expression rather than a substring
+     */
+    void setPattern(const int generation, const QString& pattern, const bool regex);
+
+    /**
+     * Scans the next chunk of finished lines not seen yet, and queues another scan if more are left
+     */
+    void scan();
+
+signals:
+    /**
+     * Emitted with the matching lines of each chunk, in increasing order
+     *
+     * @param generation the generation of the pattern they match
+     * @param lines the matching lines, numbered from the start of the stream
+     */
+    void matchesFound(const int generation, const QVector<qint64>& lines);
+
+private:
+    /**
+     * The lines searched
+     */
+    const LineStore* m_lines;
+
+    /**
+     * Lock of the lines
+     */
+    QReadWriteLock* m_lock;
+
+    /**
+     * Generation of the current pattern
+     */
+    int m_generation;
+
+    /**
+     * Whether there is a pattern to search for
+     */
+    bool m_active;
+
+    /**
+     * Whether the pattern is a regular expression
+     */
+    bool m_regex;
+
+    /**
+     * Finds the pattern as a substring, in the UTF-8 text of the lines
+     */
+    QByteArrayMatcher m_matcher;
+
+    /**
+     * The pattern as a regular expression
+     */
+    QRegularExpression m_expression;
+
+    /**
+     * The first line not scanned yet, numbered from the start of the stream
+     */
+    qint64 m_nextLine;
+
+    /**
+     * Finds the lines containing the substring in one pass over their text
+     *
+     * @param begin the first line
+     * @param end one past the last line
+     * @param matches where the matching lines are appended
+     */
+    void matchSubstring(const int begin, const int end, QVector<qint64>& matches) const;
+
+    /**
+     * Finds the lines matching the regular expression
+     *
+     * @param begin the first line
+     * @param end one past the last line
+     * @param matches where the matching lines are appended
+     */
+    void matchExpression(const int begin, const int end, QVector<qint64>& matches) const;
+};
+
+#endif // LINESEARCHER_H
@@ -0,0 +1,94 @@
+/**
+ * @file linestore.cpp
+ * @brief Implementation of LineStore class
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#include "linestore.h"
+#include <cstring>
+
+// bytes kept at most, so the offsets in the index never overflow
+#define MAXARENABYTES (1 << 30)
+
+LineStore::LineStore(const int maximumLineCount) :
+    m_firstLine(0),
+    m_maximumLineCount(qMax(maximumLineCount, 1)),
+    m_droppedLines(0),
+    m_longestLine(0) {}
+
+void LineStore::setMaximumLineCount(const int lines) {
+    m_maximumLineCount = qMax(lines, 1);
+    trim();
+}
+
+int LineStore::lineLength(const int index) const {
+    const int line = m_firstLine + index;
+    if (line + 1 < m_lineStarts.size()) {
+        // leave out the newline ending every line but the last
+        return m_lineStarts[line + 1] - 1 - m_lineStarts[line];
+    }
+    const int end = m_data.size() - (m_data.endsWith('\n') ? 1 : 0);
+    return end - m_lineStarts[line];
+}
+
+void LineStore::append(const char* data, const int length) {
+    if (length <= 0) return;
+    // the line after a newline only starts once there is text for it
+    if (m_data.isEmpty() || m_data.endsWith('\n')) {
+        m_lineStarts.append(m_data.size());
+    }
+    const int base = m_data.size();
+    m_data.append(data, length);
+    const char* p = data;
+    const char* const end = data + length;
+    while (p < end) {
+        const char* newline = static_cast<const char*>(memchr(p, '\n', size_t(end - p)));
+        if (newline == nullptr) break;
+        const int lineStart = m_lineStarts.last();
+        m_longestLine = qMax(m_longestLine, base + int(newline - data) - lineStart);
+        p = newline + 1;
+        if (p < end) {
+            m_lineStarts.append(base + int(p - data));
+        }
+    }
+    if (!m_data.endsWith('\n')) {
+        m_longestLine = qMax(m_longestLine, m_data.size() - m_lineStarts.last());
+    }
+    trim();
+}
+
+QByteArray LineStore::text() const {
+    if (lineCount() == 0) return QByteArray();
+    return m_data.mid(m_lineStarts[m_firstLine]);
+}
+
+void LineStore::clear() {
+    m_droppedLines += lineCount();
+    m_data.clear();
+    m_lineStarts.clear();
+    m_firstLine = 0;
+    m_longestLine = 0;
+}
+
+void LineStore::trim() {
+    int excess = qMax(0, lineCount() - m_maximumLineCount);
+    // a single line longer than the arena is still kept whole
+    while (lineCount() - excess > 1 && m_data.size() - m_lineStarts[m_firstLine + excess] > MAXARENABYTES) {
+        ++excess;
+    }
+    if (excess <= 0) return;
+    m_firstLine += excess;
+    m_droppedLines += excess;
+    // moving the kept lines down costs as much as the lines dropped since the last time
+    const int dropped = m_lineStarts[m_firstLine];
+    if (dropped < m_data.size() - dropped && m_firstLine < lineCount()) return;
+    m_data.remove(0, dropped);
+    m_lineStarts.remove(0, m_firstLine);
+    m_firstLine = 0;
+    for (int& start : m_lineStarts) {
+        start -= dropped;
+    }
+}
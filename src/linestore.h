@@ -0,0 +1,134 @@
+/**
+ * @file linestore.h
+ * @brief Append-only store of the newest lines of a stream
+ *
+ * The lines are kept back to back in one arena, with the offset of the start of each
+ * line in an index, so appending costs the same however many lines are kept and
+ * any line is found in constant time.
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#ifndef LINESTORE_H
+#define LINESTORE_H
+
+#include <QByteArray>
+#include <QVector>
+
+class LineStore {
+public:
+    /**
+     * Constructs an empty store
+     *
+     * @param maximumLineCount the maximum number of lines kept, older ones are dropped
+     */
+    explicit LineStore(const int maximumLineCount = 1);
+
+    /**
+     * Changes the maximum number of lines, dropping the oldest ones that don't fit
+     *
+     * @param lines the new maximum
+     */
+    void setMaximumLineCount(const int lines);
+
+    /**
+     * @return the maximum number of lines kept
+     */
+    int maximumLineCount() const { return m_maximumLineCount; }
+
+    /**
+     * @return the number of lines kept, including the last one if it isn't finished yet
+     */
+    int lineCount() const { return m_lineStarts.size() - m_firstLine; }
+
+    /**
+     * @return the number of lines kept that end in a newline, which are never changed again
+     */
+    int finishedLineCount() const { return lineCount() - (m_data.endsWith('\n') || m_data.isEmpty() ? 0 : 1); }
+
+    /**
+     * @return the number of lines dropped from the top since the store was constructed
+     */
+    qint64 droppedLineCount() const { return m_droppedLines; }
+
+    /**
+     * @return the length of the longest line appended since the store was last cleared
+     */
+    int longestLineLength() const { return m_longestLine; }
+
+    /**
+     * Appends text to the stream, a newline finishes the current line
+     *
+     * @param data the text, UTF-8 encoded
+     * @param length the number of bytes
+     */
+    void append(const char* data, const int length);
+
+    /**
+     * @param index the line, 0 being the oldest one kept
+     * @return the start of the line, valid until the next change to the store
+     */
+    const char* lineData(const int index) const { return m_data.constData() + m_lineStarts[m_firstLine + index]; }
+
+    /**
+     * @param index the line, 0 being the oldest one kept
+     * @return the length of the line in bytes, without the newline
+     */
+    int lineLength(const int index) const;
+
+    /**
+     * @param index the line, 0 being the oldest one kept
+     * @return a copy of the line, without the newline
+     */
+    QByteArray line(const int index) const { return QByteArray(lineData(index), lineLength(index)); }
+
+    /**
+     * @return a copy of all lines kept, with their newlines
+     */
+    QByteArray text() const;
+
+    /**
+     * Removes all lines, dropped lines keep being counted
+     */
+    void clear();
+
+private:
+    /**
+     * The lines back to back, each finished one ending in a newline
+     */
+    QByteArray m_data;
+
+    /**
+     * Offset in `m_data` of the start of every line, including ones dropped since the last compaction
+     */
+    QVector<int> m_lineStarts;
+
+    /**
+     * Index in `m_lineStarts` of the oldest line kept
+     */
+    int m_firstLine;
+
+    /**
+     * The maximum number of lines kept
+     */
+    int m_maximumLineCount;
+
+    /**
+     * The number of lines dropped from the top
+     */
+    qint64 m_droppedLines;
+
+    /**
+     * The length of the longest line, for the width of the view
+     */
+    int m_longestLine;
+
+    /**
+     * Drops the oldest lines over the maximum, and reclaims their space once it is most of the arena
+     */
+    void trim();
+};
+
+#endif // LINESTORE_H
@@ -0,0 +1,207 @@
+/**
+ * @file logview.cpp
+ * @brief Implementation of LogView class
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#include "logview.h"
+#include <QApplication>
+#include <QClipboard>
+#include <QMenu>
+#include <QPainter>
+#include <QScrollBar>
+#include <algorithm>
+#include <climits>
+
+#define DEFAULTLINES 10000
+
+LogView::LogView(QWidget* parent) :
+    RowView(parent),
+    m_lines(DEFAULTLINES),
+    m_firstMatch(0),
+    m_filtered(false),
+    m_currentMatch(-1) {
+    updateScrollBars();
+}
+
+void LogView::setMaximumLineCount(const int lines) {
+    const qint64 dropped = m_lines.droppedLineCount();
+    {
+        QWriteLocker locker(&m_lock);
+        m_lines.setMaximumLineCount(lines);
+    }
+    linesChanged(dropped);
+}
+
+QString LogView::toPlainText() const {
+    return QString::fromUtf8(m_lines.text());
+}
+
+QString LogView::formatLine(const char* data, int length, const int maximumBytes) {
+    if (length > 0 && data[length - 1] == '\r') --length;
+    return QString::fromUtf8(data, qMin(length, maximumBytes));
+}
+
+void LogView::append(const QString& text) {
+    const qint64 dropped = m_lines.droppedLineCount();
+    const QByteArray utf8 = text.toUtf8();
+    {
+        QWriteLocker locker(&m_lock);
+        m_lines.append(utf8.constData(), utf8.size());
+    }
+    linesChanged(dropped);
+}
+
+void LogView::clear() {
+    const qint64 dropped = m_lines.droppedLineCount();
+    {
+        QWriteLocker locker(&m_lock);
+        m_lines.clear();
+    }
+    linesChanged(dropped);
+}
+
+void LogView::copyAll() {
+    QApplication::clipboard()->setText(toPlainText());
+}
+
+void LogView::addMatches(const QVector<qint64>& lines) {
+    const qint64 firstLine = m_lines.droppedLineCount();
+    for (const qint64 line : lines) {
+        if (line >= firstLine && (m_matches.isEmpty() || line > m_matches.last())) {
+            m_matches.append(line);
+        }
+    }
+    if (m_filtered) updateScrollBars();
+    viewport()->update();
+}
+
+void LogView::clearMatches() {
+    m_matches.clear();
+    m_firstMatch = 0;
+    m_currentMatch = -1;
+    if (m_filtered) updateScrollBars();
+    viewport()->update();
+}
+
+void LogView::setFiltered(const bool filtered) {
+    if (filtered == m_filtered) return;
+    // the current match or the top line stays in view
+    const qint64 anchor = m_currentMatch >= m_lines.droppedLineCount() ? m_currentMatch : topLine();
+    m_filtered = filtered;
+    // the selected rows would be other lines now
+    clearSelection();
+    updateScrollBars();
+    scrollToLine(anchor);
+    viewport()->update();
+}
+
+bool LogView::findNext() {
+    if (matchCount() == 0) return false;
+    const qint64* const first = m_matches.constBegin() + m_firstMatch;
+    const qint64* const last = m_matches.constEnd();
+    const qint64* next = m_currentMatch >= m_lines.droppedLineCount()
+            ? std::upper_bound(first, last, m_currentMatch)
+            : std::lower_bound(first, last, topLine());
+    // wraps around to the oldest
+    if (next == last) next = first;
+    moveToMatch(int(next - m_matches.constBegin()));
+    return true;
+}
+
+bool LogView::findPrevious() {
+    if (matchCount() == 0) return false;
+    const qint64* const first = m_matches.constBegin() + m_firstMatch;
+    const qint64* const last = m_matches.constEnd();
+    const qint64* next = std::lower_bound(first, last,
+            m_currentMatch >= m_lines.droppedLineCount() ? m_currentMatch : topLine());
+    // wraps around to the newest
+    if (next == first) next = last;
+    moveToMatch(int(next - 1 - m_matches.constBegin()));
+    return true;
+}
+
+void LogView::paintEvent(QPaintEvent*) {
+    QPainter painter(viewport());
+    painter.setFont(font());
+    const QFontMetrics metrics = fontMetrics();
+    const int lineHeight = metrics.height();
+    const int x = rowX();
+    // a character takes up at least one byte, so no more bytes than columns can be in view
+    const int visibleBytes = (horizontalScrollBar()->value() + viewport()->width()) / qMax(1, metrics.averageCharWidth()) + 1;
+    const int firstRow = verticalScrollBar()->value();
+    const qint64 currentLine = m_currentMatch - m_lines.droppedLineCount();
+    // only the lines in view are ever laid out
+    for (int i = 0; i * lineHeight < viewport()->height() && firstRow + i < rowCount(); ++i) {
+        const int index = lineOfRow(firstRow + i);
+        const QString line = formatLine(m_lines.lineData(index), m_lines.lineLength(index), visibleBytes);
+        if (index == currentLine || isRowSelected(firstRow + i)) {
+            painter.fillRect(0, i * lineHeight, viewport()->width(), lineHeight, palette().highlight());
+            painter.setPen(palette().highlightedText().color());
+        } else {
+            painter.setPen(palette().text().color());
+        }
+        painter.drawText(QRect(x, i * lineHeight, INT_MAX / 2, lineHeight),
+                         Qt::AlignLeft | Qt::AlignVCenter | Qt::TextSingleLine | Qt::TextExpandTabs, line);
+    }
+}
+
+QString LogView::rowText(const int row) const {
+    const int index = lineOfRow(row);
+    return formatLine(m_lines.lineData(index), m_lines.lineLength(index), INT_MAX);
+}
+
+void LogView::addMenuActions(QMenu& menu) {
+    RowView::addMenuActions(menu);
+    menu.addAction("Copy All", this, &LogView::copyAll)->setEnabled(m_lines.lineCount() > 0);
+}
+
+int LogView::lineOfRow(const int row) const {
+    return m_filtered ? int(m_matches[m_firstMatch + row] - m_lines.droppedLineCount()) : row;
+}
+
+qint64 LogView::topLine() const {
+    const int row = verticalScrollBar()->value();
+    return m_lines.droppedLineCount() + (row < rowCount() ? lineOfRow(row) : 0);
+}
+
+int LogView::trimMatches() {
+    const qint64 firstLine = m_lines.droppedLineCount();
+    int dropped = 0;
+    while (dropped < matchCount() && m_matches[m_firstMatch + dropped] < firstLine) {
+        ++dropped;
+    }
+    m_firstMatch += dropped;
+    // like the lines, dropped matches are only removed once they are most of them
+    if (m_firstMatch > 0 && m_firstMatch >= matchCount()) {
+        m_matches.remove(0, m_firstMatch);
+        m_firstMatch = 0;
+    }
+    return dropped;
+}
+
+void LogView::linesChanged(const qint64 dropped) {
+    const int droppedLines = int(m_lines.droppedLineCount() - dropped);
+    const int droppedMatches = trimMatches();
+    updateScrollBars(m_filtered ? droppedMatches : droppedLines);
+    viewport()->update();
+}
+
+void LogView::scrollToLine(const qint64 line) {
+    int row = int(line - m_lines.droppedLineCount());
+    if (m_filtered) {
+        const qint64* const first = m_matches.constBegin() + m_firstMatch;
+        row = int(std::lower_bound(first, m_matches.constEnd(), line) - first);
+    }
+    QScrollBar* vertical = verticalScrollBar();
+    vertical->setValue(row - vertical->pageStep() / 2);
+}
+
+void LogView::moveToMatch(const int match) {
+    m_currentMatch = m_matches[match];
+    scrollToLine(m_currentMatch);
+    viewport()->update();
+}
@@ -0,0 +1,214 @@
+/**
+ * @file logview.h
+ * @brief Monitor view showing the input as lines of text
+ *
+ * The lines are kept in a LineStore and only the ones in the viewport are laid out
+ * when it is painted, so appending and scrolling stay fast with millions of lines kept.
+ * Lines found by a search are kept in an index next to them, which the view can step
+ * through or show on their own.
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#ifndef LOGVIEW_H
+#define LOGVIEW_H
+
+#include <QReadWriteLock>
+#include <QVector>
+#include "linestore.h"
+#include "rowview.h"
+
+class LogView : public RowView
+{
+    Q_OBJECT
+public:
+    /**
+     * Constructs an empty view
+     *
+     * @param parent the parent widget
+     */
+    explicit LogView(QWidget* parent = nullptr);
+
+    /**
+     * Changes how many lines are kept, dropping the oldest ones first
+     *
+     * @param lines the number of lines
+     */
+    void setMaximumLineCount(const int lines);
+
+    /**
+     * @return the lines kept by the view
+     */
+    const LineStore& lines() const { return m_lines; }
+
+    /**
+     * @return the lock held for writing while the lines change, for reading them from other threads
+     */
+    QReadWriteLock* lock() const { return &m_lock; }
+
+    /**
+     * @return all lines kept, as they were appended
+     */
+    QString toPlainText() const;
+
+    /**
+     * @return the number of rows, which are only the matching lines while filtered
+     */
+    int rowCount() const override { return m_filtered ? matchCount() : m_lines.lineCount(); }
+
+    /**
+     * @return the number of matching lines kept
+     */
+    int matchCount() const { return m_matches.size() - m_firstMatch; }
+
+    /**
+     * @return the matching line last moved to, numbered from the start of the stream, or -1 if none
+     */
+    qint64 currentMatch() const { return m_currentMatch; }
+
+    /**
+     * @return whether only the matching lines are shown
+     */
+    bool isFiltered() const { return m_filtered; }
+
+    /**
+     * Decodes a line as it is shown, without the CR of a CRLF line ending
+     *
+     * @param data the UTF-8 text of the line, without its LF
+     * @param length the number of bytes of the line
+     * @param maximumBytes the number of bytes that can be in view, the rest is left out
+     * @return the text shown
+     */
+    static QString formatLine(const char* data, int length, const int maximumBytes);
+
+public slots:
+    /**
+     * Appends text to the end of the log, keeping the lines in view unless they were dropped
+     *
+     * @param text the text
+     */
+    void append(const QString& text);
+
+    /**
+     * Removes all lines
+     */
+    void clear();
+
+    /**
+     * Copies all lines kept to the clipboard
+     */
+    void copyAll();
+
+    /**
+     * Adds lines found by a search, which come after all the ones added before
+     *
+     * @param lines the matching lines, numbered from the start of the stream
+     */
+    void addMatches(const QVector<qint64>& lines);
+
+    /**
+     * Forgets the matching lines, for a new search
+     */
+    void clearMatches();
+
+    /**
+     * Shows only the matching lines, or all of them
+     *
+     * @param filtered whether only the matching lines are shown
+     */
+    void setFiltered(const bool filtered);
+
+    /**
+     * Moves to the next matching line, after the last one moved to or the top of the view
+     *
+     * @return whether there is a matching line
+     */
+    bool findNext();
+
+    /**
+     * Moves to the previous matching line, before the last one moved to or the top of the view
+     *
+     * @return whether there is a matching line
+     */
+    bool findPrevious();
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    qint64 rowLength() const override { return m_lines.longestLineLength(); }
+    QString rowText(const int row) const override;
+    void addMenuActions(QMenu& menu) override;
+
+private:
+    /**
+     * The newest lines of the input
+     */
+    LineStore m_lines;
+
+    /**
+     * Held for writing while the lines change
+     */
+    mutable QReadWriteLock m_lock;
+
+    /**
+     * The matching lines, numbered from the start of the stream, including ones dropped since the last compaction
+     */
+    QVector<qint64> m_matches;
+
+    /**
+     * Index in `m_matches` of the oldest matching line kept
+     */
+    int m_firstMatch;
+
+    /**
+     * Whether only the matching lines are shown
+     */
+    bool m_filtered;
+
+    /**
+     * The matching line last moved to, -1 if none
+     */
+    qint64 m_currentMatch;
+
+    /**
+     * @param row the row
+     * @return the index of the line shown in the row
+     */
+    int lineOfRow(const int row) const;
+
+    /**
+     * @return the line in the top row of the view, numbered from the start of the stream
+     */
+    qint64 topLine() const;
+
+    /**
+     * Drops matching lines that aren't kept anymore
+     *
+     * @return the number of matching lines dropped
+     */
+    int trimMatches();
+
+    /**
+     * Updates the view after lines were appended or dropped
+     *
+     * @param dropped the number of lines dropped from the top before the change
+     */
+    void linesChanged(const qint64 dropped);
+
+    /**
+     * Scrolls the view so a line is in the middle of it
+     *
+     * @param line the line, numbered from the start of the stream
+     */
+    void scrollToLine(const qint64 line);
+
+    /**
+     * Moves to a matching line and highlights it
+     *
+     * @param match index of the line in `m_matches`
+     */
+    void moveToMatch(const int match);
+};
+
+#endif // LOGVIEW_H
@@ -1,35 +1,156 @@
 #include "mainwindow.h"
+#include "headlessstreamer.h"
 #include <QApplication>
+#include <clocale>
+#include <cstdio>
+
+#define DEFAULTBAUDRATE 9600
+// how often --stats prints the stats, in milliseconds
+#define STATSINTERVAL 1000
+
+/**
+ * Streams the port to stdout or a file from a single thread, without any widgets
+ */
+static int runHeadless(QCoreApplication& a, const QCommandLineParser& parser) {
+    // QCoreApplication picks up the environment's locale, but CSV needs a decimal point
+    setlocale(LC_NUMERIC, "C");
+
+    QString port = parser.value("p");
+    if (port.isEmpty()) {
+        const QList<QSerialPortInfo> ports = QSerialPortInfo::availablePorts();
+        if (ports.isEmpty()) {
+            fprintf(stderr, "No serial ports available\n");
+            return 1;
+        }
+        port = ports.first().portName();
+    }
+    const qint32 baudRate = parser.isSet("r") ? parser.value("r").toInt() : DEFAULTBAUDRATE;
+
+    // unbuffered, since the streamer already writes one whole input buffer at a time
+    QFile out;
+    const QString path = parser.value("o");
+    bool opened;
+    if (path.isEmpty()) {
+        opened = out.open(fileno(stdout), QIODevice::WriteOnly | QIODevice::Unbuffered);
+    } else {
+        out.setFileName(path);
+        opened = out.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered);
+    }
+    if (!opened) {
+        fprintf(stderr, "Failed to open output: %s\n", qPrintable(out.errorString()));
+        return 1;
+    }
+
+    HeadlessStreamer streamer(&out, parser.isSet("raw"));
+    // the counters are only read when asked for
+    PipelineStats stats;
+    PipelineStats::Snapshot statsSnapshot = stats.snapshot();
+    QTimer statsTimer;
+    if (parser.isSet("stats")) {
+        streamer.setStats(&stats);
+        QObject::connect(&statsTimer, &QTimer::timeout, [&stats, &statsSnapshot]() {
+            const PipelineStats::Snapshot snapshot = stats.snapshot();
+            fprintf(stderr, "%s\n", qUtf8Printable(PipelineStats::summary(statsSnapshot, snapshot)));
+            statsSnapshot = snapshot;
+        });
+        statsTimer.start(STATSINTERVAL);
+    }
+    QObject::connect(&streamer, &HeadlessStreamer::failed, [](const QString& message) {
+        fprintf(stderr, "%s\n", qPrintable(message));
+        QCoreApplication::exit(1);
+    });
+    // started from the event loop, so errors while opening can end it
+    QTimer::singleShot(0, &streamer, [&streamer, port, baudRate]() {
+        streamer.start(port, baudRate);
+    });
+    return a.exec();
+}
+
+/**
+ * Opens a window monitoring one port, from which the user can open more windows
+ */
+static MainWindow* openSession(const QString& port, const QString& baudRate, const bool immediate,
+                               PlotterView* sharedPlotterView) {
+    MainWindow* w = new MainWindow(port, baudRate, immediate);
+    w->setAttribute(Qt::WA_DeleteOnClose);
+    if (sharedPlotterView != nullptr) {
+        w->setSharedPlotterView(sharedPlotterView);
+    }
+    QObject::connect(w, &MainWindow::newWindowRequested, [w, baudRate, sharedPlotterView]() {
+        MainWindow* next = openSession(QString(), baudRate, false, sharedPlotterView);
+        next->move(w->pos() + QPoint(30, 30));
+        next->show();
+    });
+    return w;
+}
 
 int main(int argc, char *argv[]) {
-    QApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
-    QApplication a(argc, argv);
+    // the kind of application has to be known before the arguments can be parsed
+    bool headless = false;
+    for (int i = 1; i < argc; ++i) {
+        if (qstrcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        }
+    }
+    QScopedPointer<QCoreApplication> app;
+    if (headless) {
+        app.reset(new QCoreApplication(argc, argv));
+    } else {
+        QApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
+        app.reset(new QApplication(argc, argv));
+    }
     QCommandLineParser parser;
     parser.addOptions({
         {{"p", "port"},
-            "Set port to <port>.",
+            "Set port to <port>, repeat to open a window for each port.",
             "port"},
         {{"r", "baud-rate"},
-            "Set baud rate to <rate>.",
+            "Set baud rate to <rate>, repeat to set it for each port.",
             "rate"},
+        {"shared-plot",
+            "Plot the input of all windows in one plotter."},
         {{"i", "immediate"},
             "Start monitoring the port immediately if possible."},
+        {"headless",
+            "Stream parsed rows as CSV without opening a window."},
+        {{"o", "output"},
+            "With --headless, write to <file> instead of stdout.",
+            "file"},
+        {"raw",
+            "With --headless, write the input as is instead of CSV."},
+        {"stats",
+            "With --headless, print throughput and latency to stderr every second."},
     });
     parser.addHelpOption();
-    parser.process(a);
-    const QString port = parser.value("p");
-    const QString baudRate = parser.value("r");
+    parser.process(*app);
+    if (headless) {
+        return runHeadless(*app, parser);
+    }
+
+    const QStringList ports = parser.values("p");
+    const QStringList baudRates = parser.values("r");
     const bool immediate = parser.isSet("i");
-    MainWindow w(port, baudRate, immediate);
-    w.setGeometry(
-        QStyle::alignedRect(
-            Qt::LeftToRight,
-            Qt::AlignCenter,
-            w.size(),
-            qApp->screens()[qApp->desktop()->screenNumber()]->availableGeometry()
-        )
-    );
-    w.show();
+    QScopedPointer<PlotterView> sharedPlotterView;
+    if (parser.isSet("shared-plot")) {
+        sharedPlotterView.reset(new PlotterView);
+        // the windows own the application, not the plotter they share
+        sharedPlotterView->setAttribute(Qt::WA_QuitOnClose, false);
+    }
+    // one window per port, each with its own reader and worker threads
+    const int sessions = qMax(1, ports.length());
+    for (int i = 0; i < sessions; ++i) {
+        const QString baudRate = baudRates.isEmpty() ? QString() : baudRates.value(i, baudRates.last());
+        MainWindow* w = openSession(ports.value(i), baudRate, immediate, sharedPlotterView.data());
+        w->setGeometry(
+            QStyle::alignedRect(
+                Qt::LeftToRight,
+                Qt::AlignCenter,
+                w->size(),
+                qApp->screens()[qApp->desktop()->screenNumber()]->availableGeometry()
+            ).translated(30 * i, 30 * i)
+        );
+        w->show();
+    }
 
-    return a.exec();
+    return app->exec();
 }
@@ -20,6 +20,10 @@
 #include <QListWidget>
 #include <QMessageBox>
 #include <QLineEdit>
+#include <QSpinBox>
+#include <QFileDialog>
+#include <QShortcut>
+#include <algorithm>
 
 // Logging modes
 #define QMESSAGE 0
@@ -28,13 +32,41 @@
 #define STDERR 3
 #define SILENT 4
 
+#define DEFAULTSCROLLBACK 10000
+// about one frame of a 60 Hz display, in milliseconds
+#define OUTPUTINTERVAL 16
+// how often the stats are updated while shown, in milliseconds
+#define STATSINTERVAL 1000
+
+namespace {
+
+/**
+ * Whether the port is the one given by name, like ttyUSB0, or by path, like /dev/ttyUSB0
+ */
+bool isPort(const QSerialPortInfo& portInfo, const QString& port) {
+    return port == portInfo.portName() || port == portInfo.systemLocation();
+}
+
+}
+
 MainWindow::MainWindow(const QString& port, const QString& baudRate, const bool immediate) :
     ui(new Ui::MainWindow),
+    m_recorder(nullptr),
+    m_searchGeneration(0),
     m_plotterView(nullptr),
-    m_readFirstPass(true),
+    m_sharedPlotter(false),
+    m_plotSource(-1),
+    m_droppedLabel(new QLabel),
+    m_logView(new LogView),
+    m_hexView(new HexView),
+    m_statsLabel(new QLabel),
     m_monitorVerticalScrollBarGrabbing(false) {
 
     ui->setupUi(this);
+    // the hex view takes the place of the log view when it is selected
+    ui->horizontalLayout->insertWidget(0, m_logView);
+    ui->horizontalLayout->insertWidget(1, m_hexView);
+    m_hexView->setVisible(false);
     qint32 baudRates[] = {QSerialPort::Baud1200, QSerialPort::Baud2400, QSerialPort::Baud4800, QSerialPort::Baud9600, QSerialPort::Baud19200, QSerialPort::Baud38400, QSerialPort::Baud57600, QSerialPort::Baud115200};
 
     const int parsedRate = baudRate.toInt();
@@ -49,55 +81,166 @@ MainWindow::MainWindow(const QString& port, const QString& baudRate, const bool
     }
     ui->baudRate->setCurrentIndex(baudRateIndex);
 
+    ui->replaySpeed->addItem("1x", 1.0);
+    ui->replaySpeed->addItem("2x", 2.0);
+    ui->replaySpeed->addItem("10x", 10.0);
+    ui->replaySpeed->addItem("Max", 0.0);
+
+    ui->scrollbackSpinBox->setValue(DEFAULTSCROLLBACK);
+    handleScrollbackChanged(DEFAULTSCROLLBACK);
+    m_outputTimer.setSingleShot(true);
+    m_outputTimer.setInterval(OUTPUTINTERVAL);
+    connect(&m_outputTimer, &QTimer::timeout, this, &MainWindow::flushOutput);
+    connect(ui->scrollbackSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, &MainWindow::handleScrollbackChanged);
+
     connect(ui->monitorButton, &QToolButton::toggled, this, &MainWindow::handleMonitorToggled);
-    connect(ui->clearButton, &QToolButton::released, ui->plainTextEdit, &QPlainTextEdit::clear);
+    connect(ui->clearButton, &QToolButton::released, this, &MainWindow::clearOutput);
+    connect(ui->clearButton, &QToolButton::released, this, &MainWindow::updateSearchStatus);
     connect(ui->sendButton, &QToolButton::released, this, &MainWindow::handleSend);
     connect(ui->portReload, &QToolButton::released, this, &MainWindow::handleReloadPorts);
     connect(ui->port, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::handlePortChanged);
     connect(ui->baudRate, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::handleBaudRateChanged);
     connect(ui->lineEdit, &QLineEdit::returnPressed, this, &MainWindow::handleSend);
     connect(ui->plotterButton, &QToolButton::toggled, this, &MainWindow::handlePlotterToggled);
-    connect(&m_serialPort, &QSerialPort::errorOccurred, this, &MainWindow::handleError);
+    connect(ui->newWindowButton, &QToolButton::released, this, &MainWindow::newWindowRequested);
+    connect(ui->recordButton, &QToolButton::toggled, this, &MainWindow::handleRecordToggled);
+    connect(ui->replayButton, &QToolButton::toggled, this, &MainWindow::handleReplayToggled);
+    connect(ui->statsCheckBox, &QCheckBox::toggled, this, &MainWindow::handleStatsToggled);
+
+    m_droppedLabel->setVisible(false);
+    m_droppedLabel->setToolTip("Input dropped because the window couldn't keep up, choose to block the reader to lose nothing");
+    ui->statusBar->addPermanentWidget(m_droppedLabel);
+    m_statsLabel->setVisible(false);
+    ui->statusBar->addPermanentWidget(m_statsLabel);
+    m_statsTimer.setInterval(STATSINTERVAL);
+    connect(&m_statsTimer, &QTimer::timeout, this, &MainWindow::updateStats);
 
-    connect(ui->plainTextEdit->verticalScrollBar(), &QScrollBar::sliderPressed, this, &MainWindow::handleSliderPressed);
-    connect(ui->plainTextEdit->verticalScrollBar(), &QScrollBar::sliderReleased, this, &MainWindow::handleSliderReleased);
+    connect(m_logView->verticalScrollBar(), &QScrollBar::sliderPressed, this, &MainWindow::handleSliderPressed);
+    connect(m_logView->verticalScrollBar(), &QScrollBar::sliderReleased, this, &MainWindow::handleSliderReleased);
+    connect(m_hexView->verticalScrollBar(), &QScrollBar::sliderPressed, this, &MainWindow::handleSliderPressed);
+    connect(m_hexView->verticalScrollBar(), &QScrollBar::sliderReleased, this, &MainWindow::handleSliderReleased);
+
+    m_queue.setStats(&m_stats);
+    // the combo box items are in the same order as OutputQueue::Policy
+    connect(ui->overloadPolicy, QOverload<int>::of(&QComboBox::currentIndexChanged), &m_queue, &OutputQueue::setPolicy);
+    connect(&m_queue, &OutputQueue::dataAvailable, this, &MainWindow::drainQueue, Qt::QueuedConnection);
 
     m_worker = new Worker;
+    m_worker->setStats(&m_stats);
+    // pushed from the worker thread, the queue itself hands over to this one
+    connect(m_worker, &Worker::plotFrame, &m_queue, &OutputQueue::pushFrame, Qt::DirectConnection);
     m_worker->moveToThread(&m_workerThread);
+    // the combo box items are in the same order as Worker::InputMode
+    connect(ui->inputMode, QOverload<int>::of(&QComboBox::currentIndexChanged), m_worker, &Worker::setInputMode);
+    // and the monitor mode and format items in the same order as Worker::MonitorMode and MonitorFormat
+    connect(ui->monitorMode, QOverload<int>::of(&QComboBox::currentIndexChanged), m_worker, &Worker::setMonitorMode);
+    connect(ui->monitorMode, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::handleMonitorModeChanged);
+    connect(ui->monitorFormat, QOverload<int>::of(&QComboBox::currentIndexChanged), m_worker, &Worker::setMonitorFormat);
+    connect(ui->monitorFormat, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::handleMonitorFormatChanged);
+    m_player = new CapturePlayer;
+    m_player->setStats(&m_stats);
+    m_player->setOutputQueue(&m_queue);
+    m_player->moveToThread(&m_workerThread);
+    connect(&m_workerThread, &QThread::finished, m_player, &QObject::deleteLater);
+    // both live in the worker thread, so chunks are processed as they are replayed
+    connect(m_player, &CapturePlayer::dataRead, m_worker, &Worker::processData);
+    connect(m_player, &CapturePlayer::finished, this, &MainWindow::handleReplayFinished);
+    connect(m_player, &CapturePlayer::errorOccurred, this, &MainWindow::handleReplayError);
+    connect(this, &MainWindow::playCapture, m_player, &CapturePlayer::play);
+    connect(this, &MainWindow::stopCapture, m_player, &CapturePlayer::stop);
     m_workerThread.start();
-    connect(this, &MainWindow::sendToWorker, m_worker, &Worker::processData);
+
+    m_reader = new PortReader;
+    m_reader->setStats(&m_stats);
+    m_reader->setOutputQueue(&m_queue);
+    m_reader->moveToThread(&m_readerThread);
+    // the reader and its serial port are deleted in their own thread once it finishes
+    connect(&m_readerThread, &QThread::finished, m_reader, &QObject::deleteLater);
+    connect(this, &MainWindow::openPort, m_reader, &PortReader::open);
+    connect(this, &MainWindow::closePort, m_reader, &PortReader::close);
+    connect(this, &MainWindow::portNameChanged, m_reader, &PortReader::setPortName);
+    connect(this, &MainWindow::baudRateChanged, m_reader, &PortReader::setBaudRate);
+    connect(this, &MainWindow::baudRateChanged, m_worker, &Worker::setBaudRate);
+    connect(this, &MainWindow::sendToPort, m_reader, &PortReader::write);
+    connect(m_reader, &PortReader::dataRead, m_worker, &Worker::processData);
+    connect(m_reader, &PortReader::errorOccurred, this, &MainWindow::handleError);
+    connect(m_reader, &PortReader::written, ui->lineEdit, &QLineEdit::clear);
+    connect(&m_queue, &OutputQueue::drained, m_reader, &PortReader::resume);
+    m_readerThread.start();
+
+    m_searcher = new LineSearcher(&m_logView->lines(), m_logView->lock());
+    m_searcher->moveToThread(&m_searchThread);
+    connect(&m_searchThread, &QThread::finished, m_searcher, &QObject::deleteLater);
+    connect(this, &MainWindow::searchPatternChanged, m_searcher, &LineSearcher::setPattern);
+    connect(this, &MainWindow::linesAppended, m_searcher, &LineSearcher::scan);
+    connect(m_searcher, &LineSearcher::matchesFound, this, &MainWindow::handleMatchesFound);
+    m_searchThread.start();
+    connect(ui->searchEdit, &QLineEdit::textChanged, this, &MainWindow::handleSearchChanged);
+    connect(ui->regexCheckBox, &QCheckBox::toggled, this, &MainWindow::handleSearchChanged);
+    connect(ui->filterCheckBox, &QCheckBox::toggled, this, &MainWindow::handleFilterToggled);
+    connect(ui->searchEdit, &QLineEdit::returnPressed, this, &MainWindow::findNextMatch);
+    connect(ui->searchNextButton, &QToolButton::released, this, &MainWindow::findNextMatch);
+    connect(ui->searchPreviousButton, &QToolButton::released, this, &MainWindow::findPreviousMatch);
+    QShortcut* findShortcut = new QShortcut(QKeySequence::Find, this);
+    connect(findShortcut, &QShortcut::activated, ui->searchEdit, QOverload<>::of(&QLineEdit::setFocus));
+    connect(findShortcut, &QShortcut::activated, ui->searchEdit, &QLineEdit::selectAll);
+
     if (loadPortsAndSet(port) && immediate) {
         ui->monitorButton->setChecked(true);
         startMonitor();
     }
 
     ui->clearButton->setIcon(QIcon::fromTheme("edit-clear", QIcon(":/icons/edit-clear.svg")));
+    ui->newWindowButton->setIcon(QIcon::fromTheme("window-new", QIcon(":/icons/window-new.svg")));
     ui->plotterButton->setIcon(QIcon::fromTheme("application-graphics", QIcon(":/icons/applications-graphics.svg")));
     ui->sendButton->setIcon(QIcon::fromTheme("network-transmit", QIcon(":/icons/network-transmit.svg")));
     ui->monitorButton->setIcon(QIcon::fromTheme("media-playback-start", QIcon(":/icons/media-playback-start.svg")));
+    ui->recordButton->setIcon(QIcon::fromTheme("media-record", QIcon(":/icons/media-record.svg")));
+    ui->replayButton->setIcon(QIcon::fromTheme("document-open", QIcon(":/icons/document-open.svg")));
     ui->portReload->setIcon(QIcon::fromTheme("reload", QIcon(":/icons/reload.svg")));
 }
 
 void MainWindow::closeEvent(QCloseEvent*) {
     stopMonitor();
-    delete m_worker;
+    stopRecording();
+    emit stopCapture();
+    // stop reading before the worker goes away
+    m_readerThread.quit();
+    m_readerThread.wait();
+    // a replay may still be feeding the worker until its thread is done
     m_workerThread.quit();
     m_workerThread.wait();
+    delete m_worker;
+    // the searcher reads the log view's lines until its thread is done
+    m_searchThread.quit();
+    m_searchThread.wait();
+    // a shared plotter outlives the counters
+    if (m_sharedPlotter && m_plotSource >= 0) {
+        m_plotterView->setSourceStats(m_plotSource, nullptr);
+    }
 }
 
 MainWindow::~MainWindow() {
     delete ui;
 }
 
+void MainWindow::setSharedPlotterView(PlotterView* plotterView) {
+    m_plotterView = plotterView;
+    m_sharedPlotter = true;
+}
+
 void MainWindow::handlePortChanged(int index) {
     resetMonitor();
     if (index != -1) {
-        m_serialPort.setPortName(m_availablePorts[index].portName());
+        emit portNameChanged(m_availablePorts[index].portName());
+        if (m_plotSource >= 0) {
+            m_plotterView->setSourceName(m_plotSource, m_availablePorts[index].portName());
+        }
     }
 }
 
 void MainWindow::handleBaudRateChanged(int) {
-    m_serialPort.setBaudRate(ui->baudRate->currentData().toInt());
+    emit baudRateChanged(ui->baudRate->currentData().toInt());
 }
 
 void MainWindow::handleReloadPorts() {
@@ -116,17 +259,13 @@ void MainWindow::handleMonitorToggled(bool checked) {
     }
 }
 
-void MainWindow::handleReadyRead() {
-    // the first pass generally has corrupted data, so clear the serial port's buffer
-    if (m_readFirstPass) {
-        m_readFirstPass = false;
-        m_serialPort.clear();
-        return;
-    }
-    QByteArray buf = m_serialPort.readAll();
-    if (buf.length() > 0) {
-        emit sendToWorker(buf);
-    }
+void MainWindow::handleMonitorModeChanged(int mode) {
+    updateMonitorView();
+    ui->autoScroll->setEnabled(mode == Worker::MonitorLive);
+}
+
+void MainWindow::handleMonitorFormatChanged(int) {
+    updateMonitorView();
 }
 
 void MainWindow::handlePlotterToggled(bool checked) {
@@ -134,27 +273,32 @@ void MainWindow::handlePlotterToggled(bool checked) {
         if (m_plotterView == nullptr) {
             m_plotterView = new PlotterView(this);
         }
-        connect(m_worker, &Worker::plotPoint, m_plotterView, &PlotterView::plotPoint);
+        if (m_plotSource < 0) {
+            // the rows of this window get channels of their own, even in a shared plotter
+            m_plotSource = m_plotterView->addSource(currentPortName());
+            m_plotterView->setSourceStats(m_plotSource, &m_stats);
+        }
         connect(m_plotterView, &PlotterView::finished, ui->plotterButton, &QToolButton::setChecked);
-        m_plotterView->move(x() + 10 + width(), y());
-        m_plotterView->show();
+        if (!m_plotterView->isVisible()) {
+            m_plotterView->move(x() + 10 + width(), y());
+            m_plotterView->show();
+        }
         m_worker->plotEnabled = true;
     } else {
         m_worker->plotEnabled = false;
-        m_plotterView->close();
-        disconnect(m_worker, &Worker::plotPoint, m_plotterView, &PlotterView::plotPoint);
+        // a shared plotter stays open for the other windows
+        if (!m_sharedPlotter) {
+            m_plotterView->close();
+        }
         disconnect(m_plotterView, &PlotterView::finished, ui->plotterButton, &QToolButton::setChecked);
     }
 }
 
 void MainWindow::handleSend() {
+    // the reader opens the port if needed, and clears the text box on success
     if (ui->lineEdit->text().length() != 0 &&
-            m_availablePorts.length() != 0 &&
-            tryOpen()) {
-        m_serialPort.write(ui->lineEdit->text().toUtf8());
-        if (!m_serialPort.error()) {
-            ui->lineEdit->clear();
-        }
+            m_availablePorts.length() != 0) {
+        emit sendToPort(ui->lineEdit->text().toUtf8());
     }
 }
 
@@ -209,23 +353,196 @@ void MainWindow::handleError(QSerialPort::SerialPortError err) {
     }
 }
 
-void MainWindow::output(const QString& val) {
-    auto pte = ui->plainTextEdit;
-    auto sb = ui->plainTextEdit->verticalScrollBar();
-    auto sbVal = sb->value();
-    pte->moveCursor(QTextCursor::End);
-    pte->insertPlainText(val);
-    pte->moveCursor(QTextCursor::End);
+void MainWindow::clearOutput() {
+    // output still queued or not flushed yet would come back right after clearing
+    drainQueue();
+    m_stats.addTextShown(m_pendingOutput.size() + m_pendingBytes.size());
+    m_pendingOutput.clear();
+    m_pendingBytes.clear();
+    m_logView->clear();
+    m_hexView->clear();
+}
+
+void MainWindow::flushOutput() {
+    if (!m_pendingBytes.isEmpty()) {
+        m_hexView->append(m_pendingBytes);
+        m_stats.addTextShown(m_pendingBytes.size());
+        m_pendingBytes.clear();
+        if (ui->autoScroll->checkState() && !m_monitorVerticalScrollBarGrabbing) {
+            m_hexView->scrollToBottom();
+        }
+    }
+    if (m_pendingOutput.isEmpty()) return;
+    // the log view keeps the lines in view by itself
+    m_logView->append(m_pendingOutput);
+    m_stats.addTextShown(m_pendingOutput.size());
+    m_pendingOutput.clear();
     if (ui->autoScroll->checkState() && !m_monitorVerticalScrollBarGrabbing) {
-        sb->setValue(sb->maximum());
+        m_logView->scrollToBottom();
+    }
+    if (!ui->searchEdit->text().isEmpty()) {
+        // only the new lines are searched
+        emit linesAppended();
+        updateSearchStatus();
+    }
+}
+
+void MainWindow::handleScrollbackChanged(int lines) {
+    m_logView->setMaximumLineCount(lines);
+    m_hexView->setMaximumRowCount(lines);
+}
+
+void MainWindow::handleRecordToggled(bool checked) {
+    if (checked) {
+        const QString path = QFileDialog::getSaveFileName(this, "Record to", QString(), "Captures (*.wcap)");
+        if (path.isEmpty() || !startRecording(path)) {
+            ui->recordButton->setChecked(false);
+        }
     } else {
-        sb->setValue(sbVal);
+        stopRecording();
     }
 }
 
+bool MainWindow::startRecording(const QString& path) {
+    if (m_recorder != nullptr) {
+        stopRecording();
+    }
+    m_recorder = new CaptureWriter;
+    m_recorder->moveToThread(&m_recorderThread);
+    connect(m_recorder, &CaptureWriter::errorOccurred, this, &MainWindow::handleRecordingError);
+    m_recorderThread.start();
+    bool opened = false;
+    QMetaObject::invokeMethod(m_recorder, "open", Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(bool, opened), Q_ARG(QString, path));
+    if (!opened) {
+        m_recorderThread.quit();
+        m_recorderThread.wait();
+        delete m_recorder;
+        m_recorder = nullptr;
+        return false;
+    }
+    QMetaObject::invokeMethod(m_reader, "setRecorder", Qt::QueuedConnection, Q_ARG(CaptureWriter*, m_recorder));
+    // don't ask for a file again when started programmatically
+    const QSignalBlocker blocker(ui->recordButton);
+    ui->recordButton->setChecked(true);
+    return true;
+}
+
+void MainWindow::stopRecording() {
+    if (m_recorder == nullptr) return;
+    // the reader must be done with the capture before it goes away
+    QMetaObject::invokeMethod(m_reader, "setRecorder", Qt::BlockingQueuedConnection, Q_ARG(CaptureWriter*, nullptr));
+    QMetaObject::invokeMethod(m_recorder, "close", Qt::BlockingQueuedConnection);
+    m_recorderThread.quit();
+    m_recorderThread.wait();
+    delete m_recorder;
+    m_recorder = nullptr;
+    ui->recordButton->setChecked(false);
+}
+
+void MainWindow::handleRecordingError(const QString& message) {
+    stopRecording();
+    outputError(QString("Failed to record: %1").arg(message));
+}
+
+void MainWindow::handleReplayToggled(bool checked) {
+    if (checked) {
+        const QString path = QFileDialog::getOpenFileName(this, "Replay", QString(), "Captures (*.wcap)");
+        if (path.isEmpty()) {
+            ui->replayButton->setChecked(false);
+        } else {
+            startReplay(path);
+        }
+    } else {
+        emit stopCapture();
+        stopReplayOutput();
+    }
+}
+
+void MainWindow::startReplay(const QString& path) {
+    // the replay takes the place of the port, so their input doesn't get mixed up
+    resetMonitor();
+    // through the queue like the port's input, so a full queue holds the replay up too
+    connect(m_worker, &Worker::output, &m_queue, &OutputQueue::pushText,
+            static_cast<Qt::ConnectionType>(Qt::DirectConnection | Qt::UniqueConnection));
+    connect(m_worker, &Worker::outputBytes, &m_queue, &OutputQueue::pushBytes,
+            static_cast<Qt::ConnectionType>(Qt::DirectConnection | Qt::UniqueConnection));
+    const QSignalBlocker blocker(ui->replayButton);
+    ui->replayButton->setChecked(true);
+    emit playCapture(path, ui->replaySpeed->currentData().toReal());
+}
+
+void MainWindow::handleReplayFinished(const qint64 bytes, const qint64 elapsed) {
+    const QSignalBlocker blocker(ui->replayButton);
+    ui->replayButton->setChecked(false);
+    stopReplayOutput();
+    const qreal seconds = elapsed / 1e9;
+    ui->statusBar->showMessage(QString("Replayed %1 bytes in %2 s (%3 MB/s)")
+                               .arg(bytes)
+                               .arg(seconds, 0, 'f', 3)
+                               .arg(seconds > 0 ? bytes / seconds / 1e6 : 0.0, 0, 'f', 1));
+}
+
+void MainWindow::handleReplayError(const QString& message) {
+    const QSignalBlocker blocker(ui->replayButton);
+    ui->replayButton->setChecked(false);
+    stopReplayOutput();
+    outputError(QString("Failed to replay: %1").arg(message));
+}
+
+void MainWindow::drainQueue() {
+    m_queue.take(m_pendingOutput, m_pendingBytes, m_drainedFrames);
+    if ((!m_pendingOutput.isEmpty() || !m_pendingBytes.isEmpty()) && !m_outputTimer.isActive()) {
+        m_outputTimer.start();
+    }
+    if (!m_drainedFrames.isEmpty()) {
+        if (m_plotterView != nullptr && ui->plotterButton->isChecked()) {
+            for (SampleFrame& frame : m_drainedFrames) {
+                // the worker doesn't know about sources, so a shared plotter never waits on it
+                frame.source = m_plotSource;
+                m_plotterView->plotFrame(frame);
+            }
+        } else {
+            // frames still in flight when the plotter was closed
+            for (const SampleFrame& frame : m_drainedFrames) {
+                m_stats.addDropped(1, frame.values.size());
+            }
+        }
+        m_drainedFrames.resize(0);
+    }
+    const qint64 samples = m_queue.droppedSamples();
+    const qint64 characters = m_queue.droppedCharacters();
+    if (samples > 0 || characters > 0) {
+        m_droppedLabel->setText(QString("Dropped %1 samples, %2 characters").arg(samples).arg(characters));
+        m_droppedLabel->setVisible(true);
+    }
+}
+
+void MainWindow::handleStatsToggled(bool checked) {
+    if (checked) {
+        m_statsSnapshot = m_stats.snapshot();
+        m_statsLabel->setText("Measuring...");
+        m_statsTimer.start();
+    } else {
+        m_statsTimer.stop();
+    }
+    m_statsLabel->setVisible(checked);
+}
+
+void MainWindow::updateStats() {
+    const PipelineStats::Snapshot snapshot = m_stats.snapshot();
+    m_statsLabel->setText(PipelineStats::summary(m_statsSnapshot, snapshot));
+    m_statsSnapshot = snapshot;
+}
+
 bool MainWindow::loadPortsAndSet(const QString& initialPort) {
     m_availablePorts = QSerialPortInfo::availablePorts();
-    m_serialPort.setBaudRate(ui->baudRate->currentData().toInt());
+    // ports that can't be enumerated, like ptys, can still be given by name or path
+    if (!initialPort.isEmpty() && std::none_of(m_availablePorts.cbegin(), m_availablePorts.cend(),
+            [&initialPort](const QSerialPortInfo& portInfo) { return isPort(portInfo, initialPort); })) {
+        m_availablePorts.append(QSerialPortInfo(initialPort));
+    }
+    emit baudRateChanged(ui->baudRate->currentData().toInt());
     if (m_availablePorts.length() == 0) {
         ui->sendButton->setEnabled(false);
         ui->monitorButton->setEnabled(false);
@@ -236,31 +553,97 @@ bool MainWindow::loadPortsAndSet(const QString& initialPort) {
         int index = 0;
         for (int i = 0; i < m_availablePorts.length(); ++i) {
             auto portInfo = m_availablePorts[i];
-            if (initialPort == portInfo.portName()) {
+            if (isPort(portInfo, initialPort)) {
                 index = i;
             }
             ui->port->addItem(QString("%1: %2").arg(portInfo.manufacturer()).arg(portInfo.portName()), i);
         }
         ui->port->setCurrentIndex(index);
-        m_serialPort.setPortName(m_availablePorts[index].portName());
+        emit portNameChanged(m_availablePorts[index].portName());
         return true;
     }
 }
 
-inline void MainWindow::startMonitor() {
-    if (tryOpen()) {
-        m_readFirstPass = true;
-        connect(m_worker, &Worker::output, this, &MainWindow::output);
-        connect(&m_serialPort, &QSerialPort::readyRead, this, &MainWindow::handleReadyRead);
+void MainWindow::handleSearchChanged() {
+    ++m_searchGeneration;
+    // checked once here rather than on every status update
+    m_searchError.clear();
+    if (ui->regexCheckBox->isChecked()) {
+        const QRegularExpression expression(ui->searchEdit->text());
+        if (!expression.isValid()) {
+            m_searchError = "Invalid pattern: " + expression.errorString();
+        }
     }
+    m_logView->clearMatches();
+    emit searchPatternChanged(m_searchGeneration, ui->searchEdit->text(), ui->regexCheckBox->isChecked());
+    handleFilterToggled();
+    updateSearchStatus();
 }
 
-inline void MainWindow::stopMonitor() {
-    if (m_serialPort.isOpen()) {
-        m_serialPort.close();
+void MainWindow::handleFilterToggled() {
+    m_logView->setFiltered(ui->filterCheckBox->isChecked() && !ui->searchEdit->text().isEmpty());
+}
+
+void MainWindow::handleMatchesFound(const int generation, const QVector<qint64>& lines) {
+    if (generation != m_searchGeneration) return;
+    m_logView->addMatches(lines);
+    if (m_logView->isFiltered() && ui->autoScroll->checkState() && !m_monitorVerticalScrollBarGrabbing) {
+        m_logView->scrollToBottom();
+    }
+    updateSearchStatus();
+}
+
+void MainWindow::findNextMatch() {
+    if (m_logView->findNext()) {
+        // or new output would scroll the match out of view
+        ui->autoScroll->setChecked(false);
+    }
+}
+
+void MainWindow::findPreviousMatch() {
+    if (m_logView->findPrevious()) {
+        ui->autoScroll->setChecked(false);
+    }
+}
+
+void MainWindow::updateSearchStatus() {
+    if (ui->searchEdit->text().isEmpty()) {
+        ui->searchStatus->clear();
+        return;
+    }
+    if (!m_searchError.isEmpty()) {
+        ui->searchStatus->setText(m_searchError);
+        return;
     }
-    disconnect(&m_serialPort, &QSerialPort::readyRead, this, &MainWindow::handleReadyRead);
-    disconnect(m_worker, &Worker::output, this, &MainWindow::output);
+    const int matches = m_logView->matchCount();
+    ui->searchStatus->setText(QString("%1 %2").arg(matches).arg(matches == 1 ? "match" : "matches"));
+}
+
+void MainWindow::updateMonitorView() {
+    const bool shown = ui->monitorMode->currentIndex() != Worker::MonitorOff;
+    const bool hex = ui->monitorFormat->currentIndex() == Worker::HexFormat;
+    m_logView->setVisible(shown && !hex);
+    m_hexView->setVisible(shown && hex);
+}
+
+QString MainWindow::currentPortName() const {
+    const int index = ui->port->currentIndex();
+    return index >= 0 && index < m_availablePorts.length() ? m_availablePorts[index].portName() : QString();
+}
+
+inline void MainWindow::startMonitor() {
+    // failing to open is reported back through `handleError`, which resets the monitor
+    connect(m_worker, &Worker::output, &m_queue, &OutputQueue::pushText,
+            static_cast<Qt::ConnectionType>(Qt::DirectConnection | Qt::UniqueConnection));
+    connect(m_worker, &Worker::outputBytes, &m_queue, &OutputQueue::pushBytes,
+            static_cast<Qt::ConnectionType>(Qt::DirectConnection | Qt::UniqueConnection));
+    emit openPort();
+}
+
+inline void MainWindow::stopMonitor() {
+    emit closePort();
+    disconnect(m_worker, &Worker::output, &m_queue, &OutputQueue::pushText);
+    disconnect(m_worker, &Worker::outputBytes, &m_queue, &OutputQueue::pushBytes);
 }
 
 inline void MainWindow::resetMonitor() {
@@ -268,8 +651,10 @@ inline void MainWindow::resetMonitor() {
     ui->monitorButton->setChecked(false);
 }
 
-inline bool MainWindow::tryOpen() {
-    return m_serialPort.isOpen() || m_serialPort.open(QIODevice::ReadWrite);
+inline void MainWindow::stopReplayOutput() {
+    if (ui->monitorButton->isChecked()) return;
+    disconnect(m_worker, &Worker::output, &m_queue, &OutputQueue::pushText);
+    disconnect(m_worker, &Worker::outputBytes, &m_queue, &OutputQueue::pushBytes);
 }
 
 inline void MainWindow::outputError(const QString& errMesg) {
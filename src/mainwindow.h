@@ -17,7 +17,17 @@
 #include <QtSerialPort/QSerialPortInfo>
 #include "plotterview.h"
 #include <QThread>
+#include <QTimer>
 #include "worker.h"
+#include "portreader.h"
+#include "capturewriter.h"
+#include "captureplayer.h"
+#include "pipelinestats.h"
+#include "outputqueue.h"
+#include "logview.h"
+#include "linesearcher.h"
+#include "hexview.h"
+#include <QLabel>
 namespace Ui {
 class MainWindow;
 }
@@ -42,6 +52,15 @@ public:
      */
     ~MainWindow();
 
+    /**
+     * Makes the plotter button use a plotter shared with other windows instead of its own
+     *
+     * Must be called before the plotter is first opened
+     *
+     * @param plotterView the shared plotter, which must outlive the window
+     */
+    void setSharedPlotterView(PlotterView* plotterView);
+
 public slots:
     /**
      * Handles changes to the baud rate combo box
@@ -88,12 +107,6 @@ public slots:
      */
     void handlePortChanged(int newIndex);
 
-    /**
-     *  Reads new data from the port when available
-     *  and sends it to the worker
-     */
-    void handleReadyRead();
-
     /**
      * Handles reloading the available ports
      *
@@ -118,21 +131,217 @@ public slots:
      */
     void handleSliderReleased();
     /**
-     * Updates the textbox, and handles auto-scrolling
+     * Appends all queued output to the log view and all queued input to the hex view,
+     * and handles auto-scrolling
+     */
+    void flushOutput();
+
+    /**
+     * Clears the monitor and the hex view, along with the output queued for them
+     */
+    void clearOutput();
+
+    /**
+     * Handles changes to the monitor mode, hiding the monitor while it is off
+     *
+     * @param mode one of Worker::MonitorMode
+     */
+    void handleMonitorModeChanged(int mode);
+
+    /**
+     * Handles changes to the monitor format, showing either the log view or the hex view
+     *
+     * @param format one of Worker::MonitorFormat
+     */
+    void handleMonitorFormatChanged(int format);
+
+    /**
+     * Handles changes to the maximum number of lines kept in the monitor
+     *
+     * @param lines the new maximum, older lines are removed first
+     */
+    void handleScrollbackChanged(int lines);
+
+    /**
+     * Handles toggles to the record button
+     *
+     * If checked, asks for a file and calls `startRecording`
+     * Else, calls `stopRecording`
+     *
+     * @param checked whether the button is checked
+     */
+    void handleRecordToggled(bool checked);
+
+    /**
+     * Starts recording everything read from the port to a capture file
+     *
+     * @param path the path of the capture file, replaced if it exists
+     * @return whether the capture file was created
+     */
+    bool startRecording(const QString& path);
+
+    /**
+     * Stops recording, and finishes and closes the capture file
+     */
+    void stopRecording();
+
+    /**
+     * Handles errors of the capture file by stopping the recording
+     *
+     * @param message description of the error
+     */
+    void handleRecordingError(const QString& message);
+
+    /**
+     * Handles toggles to the replay button
+     *
+     * If checked, asks for a capture file and calls `startReplay`
+     * Else, stops the replay
+     *
+     * @param checked whether the button is checked
+     */
+    void handleReplayToggled(bool checked);
+
+    /**
+     * Stops monitoring the port and replays a capture file through the monitor and plotter
      *
-     * @param val new string to be appended to the textbox
+     * Replays at the speed selected in the replay speed combo box
+     *
+     * @param path the path of the capture file
      */
-    void output(const QString& val);
+    void startReplay(const QString& path);
+
+    /**
+     * Handles the end of a replay by reporting its throughput
+     *
+     * @param bytes the number of bytes replayed
+     * @param elapsed the time the replay took, in ns
+     */
+    void handleReplayFinished(const qint64 bytes, const qint64 elapsed);
+
+    /**
+     * Handles capture files that can't be replayed
+     *
+     * @param message description of the error
+     */
+    void handleReplayError(const QString& message);
+
+    /**
+     * Shows or hides the pipeline stats in the status bar
+     *
+     * The stats are only read while they are shown
+     *
+     * @param checked whether to show the stats
+     */
+    void handleStatsToggled(bool checked);
+
+    /**
+     * Shows the pipeline stats since the last update
+     */
+    void updateStats();
+
+    /**
+     * Takes everything the worker queued, and hands it to the monitor and the plotter
+     */
+    void drainQueue();
+
+    /**
+     * Starts a new search of the monitor for the text in the search box, and starts or stops filtering
+     */
+    void handleSearchChanged();
+
+    /**
+     * Handles the filter checkbox, showing only the matching lines while there is a search
+     */
+    void handleFilterToggled();
+
+    /**
+     * Hands lines found by the searcher to the log view, unless they match an older search
+     *
+     * @param generation the search the lines match
+     * @param lines the matching lines
+     */
+    void handleMatchesFound(const int generation, const QVector<qint64>& lines);
+
+    /**
+     * Moves the log view to the next matching line
+     */
+    void findNextMatch();
+
+    /**
+     * Moves the log view to the previous matching line
+     */
+    void findPreviousMatch();
 
 signals:
     /**
-     * Sends the newly read input buffer to the worker for processing
+     * Asks the reader to open the port and start reading from it
+     */
+    void openPort();
+
+    /**
+     * Asks the reader to stop reading and close the port
+     */
+    void closePort();
+
+    /**
+     * Sends the selected port to the reader
+     *
+     * @param name the name of the port
+     */
+    void portNameChanged(const QString& name);
+
+    /**
+     * Sends the selected baud rate to the reader
      *
-     * @param buf
+     * @param baudRate the new baud rate
      */
-    void sendToWorker(const QByteArray& buf);
+    void baudRateChanged(const qint32 baudRate);
+
+    /**
+     * Sends a buffer to the reader to be written to the board
+     *
+     * @param buf the buffer to write
+     */
+    void sendToPort(const QByteArray& buf);
+
+    /**
+     * Emitted when the user asks for another window to monitor a different port
+     */
+    void newWindowRequested();
+
+    /**
+     * Asks the player to replay a capture file
+     *
+     * @param path the path of the capture file
+     * @param speed how many times faster than recorded to replay, or 0 for as fast as possible
+     */
+    void playCapture(const QString& path, const qreal speed);
+
+    /**
+     * Asks the player to stop replaying
+     */
+    void stopCapture();
+
+    /**
+     * Sends a new search to the searcher
+     *
+     * @param generation identifies the search in the matches found
+     * @param pattern the text to look for, or an empty string to stop searching
+     * @param regex whether the pattern is a regular expression
+     */
+    void searchPatternChanged(const int generation, const QString& pattern, const bool regex);
+
+    /**
+     * Tells the searcher there are new lines in the log view
+     */
+    void linesAppended();
 
 private:
+    friend class MainWindowTest;
+    friend class MainWindowBenchmark;
+    friend class LoopbackTest;
+
     /**
      * Worker object which processes incoming data off the main thread
      */
@@ -144,14 +353,54 @@ private:
     QThread m_workerThread;
 
     /**
-     * List of available ports from last query
+     * Reader object which owns the serial port and does all I/O off the main thread
      */
-    QList<QSerialPortInfo> m_availablePorts;
+    PortReader* m_reader;
+
+    /**
+     * Thread for the reader object
+     */
+    QThread m_readerThread;
 
     /**
-     * Serial port object for serial communication
+     * Writer of the current capture file, nullptr when not recording
      */
-    QSerialPort m_serialPort;
+    CaptureWriter* m_recorder;
+
+    /**
+     * Thread for the capture writer, so the disk never holds up reading
+     */
+    QThread m_recorderThread;
+
+    /**
+     * Searcher of the lines in the log view
+     */
+    LineSearcher* m_searcher;
+
+    /**
+     * Thread for the searcher, so searching hours of output never holds up the window
+     */
+    QThread m_searchThread;
+
+    /**
+     * Increased with every new search, so matches of older ones are ignored
+     */
+    int m_searchGeneration;
+
+    /**
+     * Why the pattern in the search box can't be searched for, empty if it can
+     */
+    QString m_searchError;
+
+    /**
+     * Player for capture files, lives in the worker thread and feeds the worker directly
+     */
+    CapturePlayer* m_player;
+
+    /**
+     * List of available ports from last query
+     */
+    QList<QSerialPortInfo> m_availablePorts;
 
     /**
      * Pointer to the plotter view dialog
@@ -159,11 +408,74 @@ private:
     PlotterView* m_plotterView;
 
     /**
-     * Whether or not this is the first read after we started listening
-     *
-     * Used to clear the buffer, which may have old, corrupted data
+     * Whether the plotter is shared with other windows, and not owned by this one
      */
-    bool m_readFirstPass;
+    bool m_sharedPlotter;
+
+    /**
+     * The id of this window's rows in the plotter, -1 until it is first opened
+     */
+    int m_plotSource;
+
+    /**
+     * Bounded hand-off of monitor text and plot frames from the worker
+     */
+    OutputQueue m_queue;
+
+    /**
+     * Frames taken from the queue, reused between drains
+     */
+    QVector<SampleFrame> m_drainedFrames;
+
+    /**
+     * Shows how much input was dropped because the window couldn't keep up, hidden until something is
+     */
+    QLabel* m_droppedLabel;
+
+    /**
+     * Monitor that shows the input as lines of text
+     */
+    LogView* m_logView;
+
+    /**
+     * Output received since the log view was last updated
+     */
+    QString m_pendingOutput;
+
+    /**
+     * Monitor that shows the input as a hex dump, in place of the log view
+     */
+    HexView* m_hexView;
+
+    /**
+     * Input received since the hex view was last updated
+     */
+    QByteArray m_pendingBytes;
+
+    /**
+     * Limits updates of the monitor to one per frame
+     */
+    QTimer m_outputTimer;
+
+    /**
+     * Counters of every stage of this window's pipeline, from the port to the plotter
+     */
+    PipelineStats m_stats;
+
+    /**
+     * The counters at the last update of the stats
+     */
+    PipelineStats::Snapshot m_statsSnapshot;
+
+    /**
+     * Shows the stats in the status bar
+     */
+    QLabel* m_statsLabel;
+
+    /**
+     * Updates the stats once a second while they are shown
+     */
+    QTimer m_statsTimer;
 
     /**
      * Whether the user is currently grabbing the scrollbar in the monitor
@@ -191,11 +503,19 @@ private:
      */
 
     /**
-     * Opens the serial port of not already open
-     *
-     * @return whether the port is open without any errors
+     * @return the name of the selected port, or an empty string if there is none
+     */
+    QString currentPortName() const;
+
+    /**
+     * Shows the log view or the hex view, or neither while the monitor is off
      */
-    inline bool tryOpen();
+    void updateMonitorView();
+
+    /**
+     * Shows the number of matching lines, or why the pattern can't be searched for
+     */
+    void updateSearchStatus();
 
     /**
      * Starts listening to input from the serial port
@@ -212,6 +532,11 @@ private:
      */
     inline void resetMonitor();
 
+    /**
+     * Stops queueing the output of the replay, unless the monitor has taken over since
+     */
+    inline void stopReplayOutput();
+
     /**
      * A helper function that creates a new QMessageBox::critical with the error
      */
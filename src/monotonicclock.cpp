@@ -0,0 +1,41 @@
+/**
+ * @file monotonicclock.cpp
+ * @brief Implementation of MonotonicClock class
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#include "monotonicclock.h"
+#include <QElapsedTimer>
+
+namespace {
+
+/**
+ * The reference both clocks are read against, started together on first use
+ */
+struct ClockStart {
+    QElapsedTimer timer;
+    QDateTime wallTime;
+
+    ClockStart() : wallTime(QDateTime::currentDateTime()) {
+        timer.start();
+    }
+};
+
+const ClockStart& clockStart() {
+    // initialized exactly once, even when first used by several threads at the same time
+    static const ClockStart start;
+    return start;
+}
+
+}
+
+qint64 MonotonicClock::now() {
+    return clockStart().timer.nsecsElapsed();
+}
+
+QDateTime MonotonicClock::startTime() {
+    return clockStart().wallTime;
+}
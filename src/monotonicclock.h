@@ -0,0 +1,32 @@
+/**
+ * @file monotonicclock.h
+ * @brief Process-wide monotonic clock that input is stamped with when it is read
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#ifndef MONOTONICCLOCK_H
+#define MONOTONICCLOCK_H
+
+#include <QDateTime>
+
+class MonotonicClock {
+public:
+    /**
+     * Reads the clock, safe to call from any thread
+     *
+     * The clock starts on first use and never goes backwards, even when the wall clock is changed
+     *
+     * @return the time since the clock started, in ns
+     */
+    static qint64 now();
+
+    /**
+     * @return the wall clock time at which the clock started, to relate its times to other logs
+     */
+    static QDateTime startTime();
+};
+
+#endif // MONOTONICCLOCK_H
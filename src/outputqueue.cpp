@@ -0,0 +1,215 @@
+/**
+ * @file outputqueue.cpp
+ * @brief Implementation of OutputQueue class
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#include "outputqueue.h"
+
+// about a second of 8 channels at 20 kHz
+#define DEFAULTSAMPLECAPACITY 200000
+// about ten seconds at 921600 baud
+#define DEFAULTTEXTCAPACITY (1024 * 1024)
+
+namespace {
+
+/**
+ * Drops every other row of a frame, always keeping its newest row
+ *
+ * @return the number of samples dropped
+ */
+int dropEveryOtherRow(SampleFrame& frame) {
+    const int rows = frame.rowCount();
+    if (rows < 2) return 0;
+    const int samples = frame.values.size();
+    const bool named = !frame.channels.isEmpty();
+    int kept = 0;
+    int keptValues = 0;
+    int rowStart = 0;
+    for (int row = 0; row < rows; ++row) {
+        const int rowEnd = frame.rowEnds[row];
+        if ((rows - 1 - row) % 2 == 0) {
+            // moved down in place, rows only ever move towards the front
+            for (int i = rowStart; i < rowEnd; ++i) {
+                if (named) {
+                    frame.channels[keptValues] = frame.channels[i];
+                }
+                frame.values[keptValues++] = frame.values[i];
+            }
+            frame.rowEnds[kept] = keptValues;
+            if (row < frame.rowTimes.size()) {
+                frame.rowTimes[kept] = frame.rowTimes[row];
+            }
+            ++kept;
+        }
+        rowStart = rowEnd;
+    }
+    frame.values.resize(keptValues);
+    if (named) {
+        frame.channels.resize(keptValues);
+    }
+    frame.rowEnds.resize(kept);
+    if (frame.rowTimes.size() > kept) {
+        frame.rowTimes.resize(kept);
+    }
+    return samples - keptValues;
+}
+
+}
+
+OutputQueue::OutputQueue(QObject* parent) :
+    QObject(parent),
+    m_policy(DropOldest),
+    m_sampleCapacity(DEFAULTSAMPLECAPACITY),
+    m_textCapacity(DEFAULTTEXTCAPACITY),
+    m_samples(0),
+    m_notified(false),
+    m_full(false),
+    m_droppedSamples(0),
+    m_droppedCharacters(0),
+    m_stats(nullptr) {}
+
+void OutputQueue::setCapacity(const int samples, const int characters) {
+    QMutexLocker locker(&m_mutex);
+    m_sampleCapacity = qMax(samples, 1);
+    m_textCapacity = qMax(characters, 1);
+}
+
+void OutputQueue::setPolicy(const int policy) {
+    bool unblocked;
+    {
+        QMutexLocker locker(&m_mutex);
+        m_policy = static_cast<Policy>(policy);
+        unblocked = m_full && m_policy != BlockReader;
+        if (unblocked) m_full = false;
+    }
+    if (unblocked) emit drained();
+}
+
+bool OutputQueue::isFull() const {
+    QMutexLocker locker(&m_mutex);
+    return m_full;
+}
+
+qint64 OutputQueue::droppedSamples() const {
+    QMutexLocker locker(&m_mutex);
+    return m_droppedSamples;
+}
+
+qint64 OutputQueue::droppedCharacters() const {
+    QMutexLocker locker(&m_mutex);
+    return m_droppedCharacters;
+}
+
+void OutputQueue::pushText(const QString& text) {
+    bool wasEmpty;
+    {
+        QMutexLocker locker(&m_mutex);
+        wasEmpty = !m_notified;
+        m_text += text;
+        m_text.remove(0, outputExcess(m_text.size()));
+        m_notified = true;
+    }
+    // the window takes everything on the one event
+    if (wasEmpty) emit dataAvailable();
+}
+
+void OutputQueue::pushBytes(const QByteArray& bytes) {
+    bool wasEmpty;
+    {
+        QMutexLocker locker(&m_mutex);
+        wasEmpty = !m_notified;
+        m_bytes += bytes;
+        m_bytes.remove(0, outputExcess(m_bytes.size()));
+        m_notified = true;
+    }
+    if (wasEmpty) emit dataAvailable();
+}
+
+int OutputQueue::outputExcess(const int size) {
+    const int excess = size - m_textCapacity;
+    if (excess <= 0) return 0;
+    if (m_policy == BlockReader) {
+        m_full = true;
+        return 0;
+    }
+    // text can't be thinned out, so the oldest goes
+    m_droppedCharacters += excess;
+    if (m_stats != nullptr) {
+        m_stats->addTextShown(excess);
+    }
+    return excess;
+}
+
+void OutputQueue::pushFrame(const SampleFrame& frame) {
+    bool wasEmpty;
+    {
+        QMutexLocker locker(&m_mutex);
+        wasEmpty = !m_notified;
+        m_frames << frame;
+        m_samples += frame.values.size();
+        if (m_samples > m_sampleCapacity) {
+            shrinkFrames();
+        }
+        m_notified = true;
+    }
+    // the window takes everything on the one event
+    if (wasEmpty) emit dataAvailable();
+}
+
+void OutputQueue::shrinkFrames() {
+    if (m_policy == BlockReader) {
+        // nothing is lost, the reader stops until the window catches up
+        m_full = true;
+        return;
+    }
+    int droppedFrames = 0;
+    int droppedSamples = 0;
+    if (m_policy == Decimate) {
+        // halving every frame keeps the whole span of the queue, at a lower resolution
+        bool thinned = true;
+        while (m_samples > m_sampleCapacity && thinned) {
+            thinned = false;
+            for (SampleFrame& queued : m_frames) {
+                const int dropped = dropEveryOtherRow(queued);
+                m_samples -= dropped;
+                droppedSamples += dropped;
+                thinned = thinned || dropped > 0;
+            }
+        }
+    }
+    // frames of a single row can't be thinned any further, and the newest frame always stays
+    int first = 0;
+    while (m_samples > m_sampleCapacity && first < m_frames.size() - 1) {
+        m_samples -= m_frames[first].values.size();
+        droppedSamples += m_frames[first].values.size();
+        ++first;
+        ++droppedFrames;
+    }
+    m_frames.remove(0, first);
+    m_droppedSamples += droppedSamples;
+    if (m_stats != nullptr) {
+        m_stats->addDropped(droppedFrames, droppedSamples);
+    }
+}
+
+void OutputQueue::take(QString& text, QByteArray& bytes, QVector<SampleFrame>& frames) {
+    bool unblocked;
+    {
+        QMutexLocker locker(&m_mutex);
+        text += m_text;
+        m_text.clear();
+        bytes += m_bytes;
+        m_bytes.clear();
+        frames += m_frames;
+        m_frames.clear();
+        m_samples = 0;
+        m_notified = false;
+        unblocked = m_full;
+        m_full = false;
+    }
+    if (unblocked) emit drained();
+}
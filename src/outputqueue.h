@@ -0,0 +1,210 @@
+/**
+ * @file outputqueue.h
+ * @brief Bounded hand-off of monitor text and plot frames from the worker to the window
+ *
+ * The worker pushes into the queue from its own thread, and the window takes everything
+ * queued so far in one go. At most one event is queued for the window however much is
+ * pushed in between, and what is held is bounded, with a policy for when it is full.
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#ifndef OUTPUTQUEUE_H
+#define OUTPUTQUEUE_H
+
+#include <QObject>
+#include <QMutex>
+#include "pipelinestats.h"
+#include "sampleframe.h"
+
+class OutputQueue : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * What happens when more is pushed than the queue holds
+     */
+    enum Policy {
+        DropOldest,
+        Decimate,
+        BlockReader
+    };
+
+    /**
+     * Constructs an empty queue which drops the oldest input when full
+     *
+     * @param parent the parent QObject
+     */
+    explicit OutputQueue(QObject* parent = nullptr);
+
+    /**
+     * Changes how much the queue holds
+     *
+     * @param samples the number of plot samples
+     * @param characters the number of characters of monitor text, or bytes of the hex monitor
+     */
+    void setCapacity(const int samples, const int characters);
+
+    /**
+     * Sets the counters that dropped frames, samples and text are added to
+     *
+     * @param stats the counters, or nullptr to count nothing
+     */
+    void setStats(PipelineStats* stats) { m_stats = stats; }
+
+    /**
+     * Whether the reader should stop reading until the queue is drained, safe to call from any thread
+     *
+     * @return whether the queue is full and the policy is to block the reader
+     */
+    bool isFull() const;
+
+    /**
+     * Takes everything queued so far
+     *
+     * @param text the monitor text is appended here
+     * @param bytes the bytes for the hex monitor are appended here
+     * @param frames the plot frames are appended here, oldest first
+     */
+    void take(QString& text, QByteArray& bytes, QVector<SampleFrame>& frames);
+
+    /**
+     * @return the number of plot samples dropped so far
+     */
+    qint64 droppedSamples() const;
+
+    /**
+     * @return the number of characters of monitor text and bytes of the hex monitor dropped so far
+     */
+    qint64 droppedCharacters() const;
+
+signals:
+    /**
+     * Emitted when something is pushed into an empty queue, and not again until it is taken
+     */
+    void dataAvailable();
+
+    /**
+     * Emitted when a full queue that blocked the reader was taken, so it can read again
+     */
+    void drained();
+
+public slots:
+    /**
+     * Changes what happens when the queue is full
+     *
+     * @param policy one of Policy
+     */
+    void setPolicy(const int policy);
+
+    /**
+     * Queues monitor text, safe to call from any thread
+     *
+     * When full, the oldest text is dropped unless the policy is to block the reader
+     *
+     * @param text the text
+     */
+    void pushText(const QString& text);
+
+    /**
+     * Queues bytes for the hex monitor, safe to call from any thread
+     *
+     * They share the capacity of the monitor text, and are dropped the same way
+     *
+     * @param bytes the bytes
+     */
+    void pushBytes(const QByteArray& bytes);
+
+    /**
+     * Queues a plot frame, safe to call from any thread
+     *
+     * When full, whole frames are dropped from the front, or every other row is dropped
+     * from the queued frames with the decimate policy
+     *
+     * @param frame the frame
+     */
+    void pushFrame(const SampleFrame& frame);
+
+private:
+    /**
+     * Guards everything below
+     */
+    mutable QMutex m_mutex;
+
+    /**
+     * What happens when more is pushed than the queue holds
+     */
+    Policy m_policy;
+
+    /**
+     * The number of plot samples held before the policy applies
+     */
+    int m_sampleCapacity;
+
+    /**
+     * The number of characters of monitor text, or bytes of the hex monitor, held before the policy applies
+     */
+    int m_textCapacity;
+
+    /**
+     * Queued monitor text
+     */
+    QString m_text;
+
+    /**
+     * Queued bytes for the hex monitor
+     */
+    QByteArray m_bytes;
+
+    /**
+     * Queued plot frames, oldest first
+     */
+    QVector<SampleFrame> m_frames;
+
+    /**
+     * The number of samples in `m_frames`
+     */
+    int m_samples;
+
+    /**
+     * Whether `dataAvailable` was emitted and the queue wasn't taken since
+     */
+    bool m_notified;
+
+    /**
+     * Whether the queue filled up while blocking the reader
+     */
+    bool m_full;
+
+    /**
+     * The number of plot samples dropped so far
+     */
+    qint64 m_droppedSamples;
+
+    /**
+     * The number of characters of monitor text dropped so far
+     */
+    qint64 m_droppedCharacters;
+
+    /**
+     * Counters of the pipeline, not owned by the queue
+     */
+    PipelineStats* m_stats;
+
+    /**
+     * Applies the policy to the queued monitor output, which can't be thinned out like frames
+     *
+     * @param size the number of characters or bytes queued
+     * @return the number of the oldest ones to drop
+     */
+    int outputExcess(const int size);
+
+    /**
+     * Applies the policy to the queued frames once there are more samples than the capacity
+     */
+    void shrinkFrames();
+};
+
+#endif // OUTPUTQUEUE_H
@@ -0,0 +1,109 @@
+/**
+ * @file pipelinestats.cpp
+ * @brief Implementation of PipelineStats class
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#include "pipelinestats.h"
+#include "monotonicclock.h"
+
+namespace {
+
+QString formatDuration(const qint64 ns) {
+    if (ns < 0) return "-";
+    if (ns < 1000000) return QString("%1 µs").arg(ns / 1000);
+    return QString("%1 ms").arg(ns / 1000000);
+}
+
+QString formatRate(const qreal perSecond, const QString& unit) {
+    if (perSecond >= 1e6) return QString("%1 M%2/s").arg(perSecond / 1e6, 0, 'f', 1).arg(unit);
+    if (perSecond >= 1e3) return QString("%1 k%2/s").arg(perSecond / 1e3, 0, 'f', 1).arg(unit);
+    return QString("%1 %2/s").arg(qRound64(perSecond)).arg(unit);
+}
+
+}
+
+PipelineStats::PipelineStats() :
+    m_bytesRead(0),
+    m_bytesProcessed(0),
+    m_rowsParsed(0),
+    m_rowsRejected(0),
+    m_textQueued(0),
+    m_textShown(0),
+    m_framesQueued(0),
+    m_framesPlotted(0),
+    m_samplesPlotted(0),
+    m_framesDropped(0),
+    m_samplesDropped(0) {
+
+    for (std::atomic<qint64>& bucket : m_latencies) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+void PipelineStats::addLatency(const qint64 latency) {
+    qint64 micros = latency / 1000;
+    int bucket = 0;
+    while (micros > 0 && bucket < LATENCYBUCKETS - 1) {
+        micros >>= 1;
+        ++bucket;
+    }
+    m_latencies[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+PipelineStats::Snapshot PipelineStats::snapshot() const {
+    Snapshot snapshot;
+    snapshot.time = MonotonicClock::now();
+    // later stages first, so nothing in flight ever looks done before it started
+    snapshot.bytesProcessed = m_bytesProcessed.load(std::memory_order_relaxed);
+    snapshot.bytesRead = m_bytesRead.load(std::memory_order_relaxed);
+    snapshot.rowsParsed = m_rowsParsed.load(std::memory_order_relaxed);
+    snapshot.rowsRejected = m_rowsRejected.load(std::memory_order_relaxed);
+    snapshot.textShown = m_textShown.load(std::memory_order_relaxed);
+    snapshot.textQueued = m_textQueued.load(std::memory_order_relaxed);
+    snapshot.framesDropped = m_framesDropped.load(std::memory_order_relaxed);
+    snapshot.samplesDropped = m_samplesDropped.load(std::memory_order_relaxed);
+    snapshot.framesPlotted = m_framesPlotted.load(std::memory_order_relaxed);
+    snapshot.samplesPlotted = m_samplesPlotted.load(std::memory_order_relaxed);
+    snapshot.framesQueued = m_framesQueued.load(std::memory_order_relaxed);
+    for (int i = 0; i < LATENCYBUCKETS; ++i) {
+        snapshot.latencies[i] = m_latencies[i].load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+qint64 PipelineStats::Snapshot::latencyPercentile(const Snapshot& previous, const qreal percentile) const {
+    qint64 total = 0;
+    for (int i = 0; i < LATENCYBUCKETS; ++i) {
+        total += latencies[i] - previous.latencies[i];
+    }
+    if (total == 0) return -1;
+    const qint64 rank = qMax<qint64>(1, qint64(percentile * total + 0.5));
+    qint64 seen = 0;
+    int bucket = 0;
+    for (; bucket < LATENCYBUCKETS - 1; ++bucket) {
+        seen += latencies[bucket] - previous.latencies[bucket];
+        if (seen >= rank) break;
+    }
+    return (qint64(1) << bucket) * 1000;
+}
+
+QString PipelineStats::summary(const Snapshot& previous, const Snapshot& current) {
+    const qreal seconds = qMax<qint64>(current.time - previous.time, 1) / 1e9;
+    return QString("read %1, parsed %2 (%3 rejected), plotted %4 (%5 dropped) | queued %6 B, %7 frames, %8 chars "
+                   "| latency p50 %9, p90 %10, p99 %11")
+        .arg(formatRate((current.bytesRead - previous.bytesRead) / seconds, "B"))
+        .arg(formatRate((current.rowsParsed - previous.rowsParsed) / seconds, "rows"))
+        .arg(current.rowsRejected - previous.rowsRejected)
+        .arg(formatRate((current.samplesPlotted - previous.samplesPlotted) / seconds, "samples"))
+        .arg(current.samplesDropped - previous.samplesDropped)
+        .arg(qMax<qint64>(current.bytesRead - current.bytesProcessed, 0))
+        .arg(qMax<qint64>(current.framesQueued - current.framesPlotted - current.framesDropped, 0))
+        .arg(qMax<qint64>(current.textQueued - current.textShown, 0))
+        .arg(formatDuration(current.latencyPercentile(previous, 0.5)))
+        .arg(formatDuration(current.latencyPercentile(previous, 0.9)))
+        .arg(formatDuration(current.latencyPercentile(previous, 0.99)));
+}
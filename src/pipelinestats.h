@@ -0,0 +1,147 @@
+/**
+ * @file pipelinestats.h
+ * @brief Counters for every stage of the input pipeline, from the port to the chart
+ *
+ * Every stage adds to its counters as it goes, with one relaxed atomic add per buffer
+ * or frame rather than per byte. Nothing is computed until somebody takes a snapshot,
+ * so the counters cost next to nothing while no one is looking at them.
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#ifndef PIPELINESTATS_H
+#define PIPELINESTATS_H
+
+#include <QString>
+#include <atomic>
+
+// latencies are counted in buckets of powers of two µs, up to about half an hour
+#define LATENCYBUCKETS 32
+
+class PipelineStats {
+public:
+    /**
+     * The counters at one point in time, rates are computed between two snapshots
+     */
+    struct Snapshot {
+        qint64 time;
+        qint64 bytesRead;
+        qint64 bytesProcessed;
+        qint64 rowsParsed;
+        qint64 rowsRejected;
+        qint64 textQueued;
+        qint64 textShown;
+        qint64 framesQueued;
+        qint64 framesPlotted;
+        qint64 samplesPlotted;
+        qint64 framesDropped;
+        qint64 samplesDropped;
+        qint64 latencies[LATENCYBUCKETS];
+
+        /**
+         * Estimates a percentile of the latencies added between two snapshots
+         *
+         * @param previous the earlier snapshot
+         * @param percentile the percentile, in [0, 1]
+         * @return the upper bound of the bucket holding the percentile in ns, or -1 if there were none
+         */
+        qint64 latencyPercentile(const Snapshot& previous, const qreal percentile) const;
+    };
+
+    /**
+     * Constructs counters starting at 0
+     */
+    PipelineStats();
+
+    /**
+     * Counts bytes read from the port or a capture, by the reader
+     */
+    void addBytesRead(const qint64 bytes) { m_bytesRead.fetch_add(bytes, std::memory_order_relaxed); }
+
+    /**
+     * Counts bytes taken in by the worker, the rest are still queued for it
+     */
+    void addBytesProcessed(const qint64 bytes) { m_bytesProcessed.fetch_add(bytes, std::memory_order_relaxed); }
+
+    /**
+     * Counts lines or frames turned into rows, and those that couldn't be
+     */
+    void addRows(const int parsed, const qint64 rejected) {
+        m_rowsParsed.fetch_add(parsed, std::memory_order_relaxed);
+        m_rowsRejected.fetch_add(rejected, std::memory_order_relaxed);
+    }
+
+    /**
+     * Counts characters decoded by the worker for the monitor, or bytes for the hex view
+     */
+    void addTextQueued(const int chars) { m_textQueued.fetch_add(chars, std::memory_order_relaxed); }
+
+    /**
+     * Counts characters or bytes taken off the monitor's queue by the window, shown or cleared, or dropped by the queue
+     */
+    void addTextShown(const int chars) { m_textShown.fetch_add(chars, std::memory_order_relaxed); }
+
+    /**
+     * Counts a frame queued for the plotter by the worker
+     */
+    void addFrameQueued() { m_framesQueued.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * Counts a frame taken in by the plotter, and its samples
+     */
+    void addFramePlotted(const int samples) {
+        m_framesPlotted.fetch_add(1, std::memory_order_relaxed);
+        m_samplesPlotted.fetch_add(samples, std::memory_order_relaxed);
+    }
+
+    /**
+     * Counts frames and samples dropped on the way to the plotter because it couldn't keep up
+     */
+    void addDropped(const int frames, const int samples) {
+        m_framesDropped.fetch_add(frames, std::memory_order_relaxed);
+        m_samplesDropped.fetch_add(samples, std::memory_order_relaxed);
+    }
+
+    /**
+     * Counts the time from reading a row until it was drawn or written out
+     *
+     * @param latency the time in ns
+     */
+    void addLatency(const qint64 latency);
+
+    /**
+     * @return the current counters, each read on its own, so stages may be slightly apart
+     */
+    Snapshot snapshot() const;
+
+    /**
+     * Describes the pipeline between two snapshots in one line
+     *
+     * @param previous the earlier snapshot
+     * @param current the later snapshot
+     * @return rates of every stage, what is queued between them and latency percentiles
+     */
+    static QString summary(const Snapshot& previous, const Snapshot& current);
+
+private:
+    std::atomic<qint64> m_bytesRead;
+    std::atomic<qint64> m_bytesProcessed;
+    std::atomic<qint64> m_rowsParsed;
+    std::atomic<qint64> m_rowsRejected;
+    std::atomic<qint64> m_textQueued;
+    std::atomic<qint64> m_textShown;
+    std::atomic<qint64> m_framesQueued;
+    std::atomic<qint64> m_framesPlotted;
+    std::atomic<qint64> m_samplesPlotted;
+    std::atomic<qint64> m_framesDropped;
+    std::atomic<qint64> m_samplesDropped;
+
+    /**
+     * Number of latencies in [2^(i-1), 2^i) µs for bucket i, bucket 0 holding those under 1 µs
+     */
+    std::atomic<qint64> m_latencies[LATENCYBUCKETS];
+};
+
+#endif // PIPELINESTATS_H
@@ -11,12 +11,19 @@
 
 #include "plotterview.h"
 #include "ui_plotterview.h"
+#include "monotonicclock.h"
 #include <QToolButton>
 
 #define DEFAULTXRANGE 500
+// in seconds
+#define DEFAULTTIMERANGE 10
+#define DEFAULTHISTORY 100000
+#define DEFAULTREFRESHRATE 60
 #define YMAGNITUDEMAX 0.00001
 // 10% margins on top and bottom
 #define CHART_MARGIN 0.1
+// decimate once there are at least this many samples per pixel
+#define DECIMATION_THRESHOLD 2
 
 using namespace QtCharts;
 
@@ -26,7 +33,8 @@ PlotterView::PlotterView(QWidget *parent) :
     m_chartView(new QChartView),
     m_axisX(new QValueAxis),
     m_axisY(new QValueAxis),
-    m_currX(0) {
+    m_currX(0),
+    m_dirty(false) {
 
     ui->setupUi(this);
     m_chartView->setRenderHint(QPainter::Antialiasing);
@@ -39,8 +47,16 @@ PlotterView::PlotterView(QWidget *parent) :
     m_chart->legend()->setLabelBrush(foregroundColor);
 
     ui->xRangeSpinBox->setValue(DEFAULTXRANGE);
+    ui->timeRangeSpinBox->setValue(DEFAULTTIMERANGE);
+    ui->timeRangeSpinBox->setVisible(false);
+    ui->historySpinBox->setValue(DEFAULTHISTORY);
+    ui->refreshRateSpinBox->setValue(DEFAULTREFRESHRATE);
+    // single shot, so the timer only runs while there is something to draw
+    m_refreshTimer.setSingleShot(true);
+    m_refreshTimer.setInterval(1000 / DEFAULTREFRESHRATE);
     m_axisX->setRange(0, DEFAULTXRANGE);
     m_axisX->setLabelsBrush(foregroundColor);
+    m_axisX->setTitleBrush(foregroundColor);
     m_axisY->setRange(-YMAGNITUDEMAX, YMAGNITUDEMAX);
     m_axisY->setLabelsBrush(foregroundColor);
     m_chart->setAxisX(m_axisX);
@@ -48,105 +64,64 @@ PlotterView::PlotterView(QWidget *parent) :
 
     connect(ui->clearButton, &QToolButton::released, this, &PlotterView::clear);
     connect(ui->xRangeSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, &PlotterView::handleChangeXRange);
+    connect(ui->timeAxisCheckBox, &QCheckBox::toggled, this, &PlotterView::handleTimeAxisToggled);
+    connect(ui->timeRangeSpinBox, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &PlotterView::handleChangeTimeRange);
+    connect(ui->historySpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, &PlotterView::handleChangeHistory);
+    connect(ui->refreshRateSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, &PlotterView::handleChangeRefreshRate);
     connect(ui->bestFitButton, &QToolButton::released, this, &PlotterView::bestFit);
+    connect(&m_refreshTimer, &QTimer::timeout, this, &PlotterView::refresh);
 
     ui->clearButton->setIcon(QIcon::fromTheme("user-trash", QIcon(":/icons/user-trash.svg")));
     ui->bestFitButton->setIcon(QIcon::fromTheme("zoom-fit-best", QIcon(":/icons/zoom-fit-best.svg")));
 }
 
+int PlotterView::windowStart() const {
+    if (!ui->timeAxisCheckBox->isChecked()) {
+        return m_currX - ui->xRangeSpinBox->value();
+    }
+    if (m_times.isEmpty()) return m_currX;
+    const qint64 range = qint64(ui->timeRangeSpinBox->value() * 1e9);
+    return m_times.lowerBound(m_times.at(m_times.endX() - 1) - range);
+}
+
+inline qreal PlotterView::rowSeconds(const int x) const {
+    if (m_times.isEmpty()) return 0;
+    // the row still being plotted has no time until it ends
+    return m_times.at(qBound(m_times.firstX(), x, m_times.endX() - 1)) / 1e9;
+}
+
 void PlotterView::bestFit() {
-    int xRange = ui->xRangeSpinBox->value();
-    if (m_lines.length() == 0) return;
-    bool maxLeftFound = false;
-    bool minLeftFound = false;
-    bool maxRightFound = false;
-    bool minRightFound = false;
-    qreal maxLeft;
-    qreal minLeft;
-    qreal maxRight;
-    qreal minRight;
+    const int windowStart = this->windowStart();
+    bool found = false;
+    qreal min = 0;
+    qreal max = 0;
     for (int i = 0; i < m_lines.length(); ++i) {
-        auto line = m_lines[i];
-        auto pts = line->pointsVector();
-        int subtracted = m_currX - xRange;
-        if (subtracted < 0) subtracted = 0;
-        int lineStart = m_linesStart[i];
-        subtracted -= lineStart;
-        if (subtracted >= 0) {
-            if (subtracted == pts.length()) {
-                --subtracted;
-            }
-            qreal leftVal = pts[subtracted].y();
-            if (minLeftFound) {
-                if (leftVal < minLeft) {
-                    minLeft = leftVal;
-                }
-            } else {
-                minLeft = leftVal;
-                minLeftFound = true;
-            }
-            if (maxLeftFound) {
-                if (leftVal > maxLeft) {
-                    maxLeft = leftVal;
-                }
-            } else {
-                maxLeft = leftVal;
-                maxLeftFound = true;
-            }
-        }
-        subtracted = m_currX - lineStart;
-        if (subtracted == pts.length()) {
-            --subtracted;
-        }
-        qreal rightVal = pts[subtracted].y();
-        if (minRightFound) {
-            if (rightVal < minRight) {
-                minRight = rightVal;
-            }
-        } else {
-            minRight = rightVal;
-            minRightFound = true;
-        }
-        if (maxRightFound) {
-            if (rightVal > maxRight) {
-                maxRight = rightVal;
-            }
-        } else {
-            maxRight = rightVal;
-            maxRightFound = true;
-        }
+        WindowExtremes& extremes = m_extremes[i];
+        const SampleBuffer& buffer = m_buffers[i];
+        // samples already dropped from the history are no longer visible either
+        extremes.discardBefore(buffer.size() > 0 ? qMax(windowStart, buffer.x(0)) : windowStart);
+        if (extremes.isEmpty()) continue;
+        if (!found || extremes.min() < min) min = extremes.min();
+        if (!found || extremes.max() > max) max = extremes.max();
+        found = true;
     }
+    if (!found) return;
+    if (min == max) {
+        // a flat line still needs a range to be drawn in
+        min -= YMAGNITUDEMAX;
+        max += YMAGNITUDEMAX;
+    }
+    yRangeSelect(min, max);
+}
 
-    /**
-     *    1   |   2   |   3   |   4   |   5   |   6
-     *     MR |    MR |    MR | ML    | ML    | ML
-     *     mR |       |       |       |       | mL
-     *        | ML    | ML    |    MR |    MR |
-     *  ML    |    mR | mL    |    mR | mL    |    MR
-     *  mL    | mL    |    mR | mL    |    mR |    mR
-     */
-
-    if (maxLeft <= maxRight) { // 1,2,3
-        if (maxLeft <= minRight) {
-            // 1
-            yRangeSelect(minLeft, maxRight);
-        } else if (minRight <= minLeft) {
-            // 3
-            yRangeSelect(minRight, maxRight);
-        } else {
-            // 2
-            yRangeSelect(minLeft, maxRight);
-        }
-    } else if (maxRight <= maxLeft) { // 6,5,4
-        if (maxRight <= minLeft) {
-            // 6
-            yRangeSelect(minRight, maxLeft);
-        } else if (minLeft <= minRight) {
-            // 4
-            yRangeSelect(minLeft, maxLeft);
-        } else {
-            // 5
-            yRangeSelect(minRight, maxLeft);
+void PlotterView::rebuildExtremes() {
+    const int windowStart = this->windowStart();
+    for (int i = 0; i < m_lines.length(); ++i) {
+        WindowExtremes& extremes = m_extremes[i];
+        const SampleBuffer& buffer = m_buffers[i];
+        extremes.clear();
+        for (int j = buffer.lowerBound(windowStart); j < buffer.size(); ++j) {
+            extremes.append(buffer.x(j), buffer.y(j));
         }
     }
 }
@@ -189,32 +164,79 @@ inline void PlotterView::yRangeSelect(const qreal& a, const qreal& b) {
     m_axisY->setRange(a - (b - a) * CHART_MARGIN / (1 - 2 * CHART_MARGIN), b + (b - a) * CHART_MARGIN / (1 - 2 * CHART_MARGIN));
 }
 
-void PlotterView::handleChangeXRange(const int xRange) {
-    // find the x value exactly one range before
-    int oneRangeBefore = m_currX - xRange;
-    if (oneRangeBefore >= 0) {
-        // we have data exactly one range before, so we can adjust accordingly
-        m_axisX->setRange(oneRangeBefore, m_currX);
-    } else {
-        // we set the range normally
-        m_axisX->setRange(0, xRange);
+void PlotterView::handleChangeXRange(const int) {
+    // a wider window needs samples which were already dropped from the extremes
+    rebuildExtremes();
+    updateSeries();
+}
+
+void PlotterView::handleChangeTimeRange(const double) {
+    rebuildExtremes();
+    updateSeries();
+}
+
+void PlotterView::handleTimeAxisToggled(const bool checked) {
+    ui->xRangeSpinBox->setVisible(!checked);
+    ui->timeRangeSpinBox->setVisible(checked);
+    // the clock is relative to when it started, the title relates it to the wall clock
+    m_axisX->setTitleText(checked ? QString("Seconds since %1").arg(MonotonicClock::startTime().toString("HH:mm:ss.zzz")) : QString());
+    rebuildExtremes();
+    updateSeries();
+}
+
+void PlotterView::handleChangeHistory(const int history) {
+    for (SampleBuffer& buffer : m_buffers) {
+        buffer.setCapacity(history);
     }
+    updateSeries();
+}
+
+void PlotterView::handleChangeRefreshRate(const int refreshRate) {
+    m_refreshTimer.setInterval(1000 / refreshRate);
 }
 
 void PlotterView::clear() {
+    m_refreshTimer.stop();
+    m_dirty = false;
     m_chart->removeAllSeries();
+    // the sources stay registered, only their lines go
+    for (Source& source : m_sources) {
+        source.lines.clear();
+        source.namedLines.clear();
+        source.pendingTime = -1;
+    }
+    m_lineSources.clear();
+    m_lineChannels.clear();
     m_lines.clear();
-    m_linesStart.clear();
+    m_buffers.clear();
+    m_decimators.clear();
+    m_extremes.clear();
     m_linesLastX.clear();
     m_currX = 0;
-    m_axisX->setRange(0, ui->xRangeSpinBox->value());
+    m_times.clear();
+    // with nothing plotted, this just resets the x-axis
+    updateSeries();
     m_axisY->setRange(-YMAGNITUDEMAX, YMAGNITUDEMAX);
 }
 
-inline QLineSeries* PlotterView::createLine() {
+inline QLineSeries* PlotterView::createLine(const int source, const int namedChannel) {
     QLineSeries* newLine = new QLineSeries;
+    if (namedChannel < 0) {
+        m_sources[source].lines << m_lines.length();
+    } else {
+        QVector<int>& namedLines = m_sources[source].namedLines;
+        while (namedLines.length() <= namedChannel) {
+            namedLines << -1;
+        }
+        namedLines[namedChannel] = m_lines.length();
+    }
+    m_lineSources << source;
+    m_lineChannels << namedChannel;
     m_lines << newLine;
-    m_linesStart << m_currX;
+    m_buffers << SampleBuffer(ui->historySpinBox->value());
+    m_decimators << MinMaxDecimator();
+    m_decimators.last().setBucketWidth(m_decimators.first().bucketWidth());
+    m_extremes << WindowExtremes();
     m_linesLastX << m_currX;
     newLine->setUseOpenGL();
     m_chart->addSeries(newLine);
@@ -223,57 +245,259 @@ inline QLineSeries* PlotterView::createLine() {
     return newLine;
 }
 
-void PlotterView::plotPoint(const qreal val, const int lineIndex, const bool increment) {
-    QLineSeries* currLine;
-    int lineDeficit = lineIndex - m_lines.length();
-    if (lineDeficit >= 0) {
-        // need to add new lines
-        for (int i = 0; i < lineDeficit; i++) {
-            QLineSeries* newLine = createLine();
-            newLine->append(m_currX, 0);
+inline void PlotterView::ensureSource(const int source) {
+    if (source >= m_sources.length()) {
+        m_sources.resize(source + 1);
+    }
+}
+
+inline void PlotterView::appendSample(const qreal val, const int source, const int channel) {
+    const QVector<int>& lines = m_sources[source].lines;
+    if (channel >= lines.length()) {
+        // need to add new lines, skipped ones start at 0
+        while (lines.length() < channel) {
+            createLine(source);
+            storeSample(m_lines.length() - 1, m_currX, 0);
         }
-        currLine = createLine();
-        currLine->append(m_currX, val);
-    } else {
-        currLine = m_lines[lineIndex];
-        QPointF newPoint(m_currX, val);
-        currLine->append(newPoint);
-        // get the position of the point on the chart;
-        auto position = m_chart->mapToPosition(newPoint);
-        auto plotArea = m_chart->plotArea();
-        if (position.x() > plotArea.right()) {
-            // scroll point into view
-            m_chart->scroll(position.x() - plotArea.right(), 0);
+        createLine(source);
+    }
+    const int lineIndex = lines[channel];
+    storeSample(lineIndex, m_currX, val);
+    m_linesLastX[lineIndex] = m_currX;
+}
+
+inline void PlotterView::appendNamedSample(const qreal val, const int source, const int channel) {
+    const QVector<int>& namedLines = m_sources[source].namedLines;
+    if (channel >= namedLines.length() || namedLines[channel] < 0) {
+        createLine(source, channel);
+    }
+    const int lineIndex = namedLines[channel];
+    storeSample(lineIndex, m_currX, val);
+    m_linesLastX[lineIndex] = m_currX;
+}
+
+inline void PlotterView::storeSample(const int lineIndex, const int x, const qreal y) {
+    m_buffers[lineIndex].append(x, y);
+    m_decimators[lineIndex].append(x, y);
+    m_extremes[lineIndex].append(x, y);
+}
+
+inline void PlotterView::endRow(const int source, const qint64 time, const bool named) {
+    // other sources don't have a row here, their lines just continue past it
+    if (!named) {
+        for (const int i : m_sources[source].lines) {
+            if (m_linesLastX[i] != m_currX) {
+                m_linesLastX[i] = m_currX;
+                storeSample(i, m_currX, 0);
+            }
+        }
+    }
+    m_times.append(time);
+    ++m_currX;
+}
+
+void PlotterView::updateLegend() {
+    for (int i = 0; i < m_lines.length(); ++i) {
+        const SampleBuffer& buffer = m_buffers[i];
+        const int channel = m_lineChannels[i];
+        // named lines go by their name, the others by their newest value
+        const QString label = channel >= 0 ? m_sources[m_lineSources[i]].channelNames.value(channel)
+                                           : QString("%1").arg(buffer.y(buffer.size() - 1));
+        if (m_sources.length() > 1) {
+            m_lines[i]->setName(QString("%1: %2").arg(m_sources[m_lineSources[i]].name, label));
+        } else {
+            m_lines[i]->setName(label);
         }
-        m_linesLastX[lineIndex] = m_currX;
     }
+}
 
-    currLine->setName(QString("%1").arg(val));
-    // adjust the chart when the value is out of range
-    if (val > m_axisY->max()) {
-        if (ui->bestFitRadio->isChecked()) {
-            bestFit();
+void PlotterView::updateSeries() {
+    const bool timeAxis = ui->timeAxisCheckBox->isChecked();
+    // find the first x value within one range before
+    const int oneRangeBefore = windowStart();
+    int rows;
+    if (timeAxis) {
+        const qreal timeRange = ui->timeRangeSpinBox->value();
+        if (!m_times.isEmpty()) {
+            const qreal newest = rowSeconds(m_times.endX() - 1);
+            m_axisX->setRange(newest - timeRange, newest);
+        } else {
+            m_axisX->setRange(0, timeRange);
+        }
+        rows = m_currX - oneRangeBefore;
+    } else {
+        rows = ui->xRangeSpinBox->value();
+        if (oneRangeBefore >= 0) {
+            // we have data exactly one range before, so we can adjust accordingly
+            m_axisX->setRange(oneRangeBefore, m_currX);
         } else {
-            yMaxSelect(val);
+            // we set the range normally
+            m_axisX->setRange(0, rows);
+        }
+    }
+    if (m_lines.length() == 0) return;
+
+    // one bucket per pixel column, or none when every sample gets its own pixel anyway
+    const qreal plotWidth = m_chart->plotArea().width();
+    int bucketWidth = plotWidth >= 1 ? int(rows / plotWidth) : 0;
+    if (bucketWidth < DECIMATION_THRESHOLD) {
+        bucketWidth = 0;
+    } else if (timeAxis) {
+        // the number of rows in a time window keeps changing, powers of two keep the buckets stable
+        int power = 1;
+        while (power * 2 <= bucketWidth) power *= 2;
+        bucketWidth = power;
+    }
+    const bool rebuild = bucketWidth != m_decimators.first().bucketWidth();
+
+    int oldestX = m_currX;
+    for (int i = 0; i < m_lines.length(); ++i) {
+        const SampleBuffer& buffer = m_buffers[i];
+        MinMaxDecimator& decimator = m_decimators[i];
+        if (buffer.size() > 0) oldestX = qMin(oldestX, buffer.x(0));
+        // kept up to date whatever the scaling mode, so Best fit can be pressed at any time
+        m_extremes[i].discardBefore(buffer.size() > 0 ? qMax(oneRangeBefore, buffer.x(0)) : oneRangeBefore);
+        // start one sample early, so the line enters from the left edge
+        int first = buffer.lowerBound(oneRangeBefore);
+        if (first > 0) --first;
+        if (rebuild) {
+            // the buckets only have to be recomputed from scratch when their width changes
+            decimator.setBucketWidth(bucketWidth);
+            for (int j = first; j < buffer.size(); ++j) {
+                decimator.append(buffer.x(j), buffer.y(j));
+            }
         }
-    } else if (val < m_axisY->min()) {
-        if (ui->bestFitRadio->isChecked()) {
-            bestFit();
+        m_visiblePoints.resize(0);
+        if (bucketWidth > 0) {
+            decimator.discardBefore(first < buffer.size() ? buffer.x(first) : m_currX);
+            decimator.points(m_visiblePoints);
+            if (timeAxis) {
+                for (QPointF& point : m_visiblePoints) {
+                    point.setX(rowSeconds(int(point.x())));
+                }
+            }
         } else {
-            yMinSelect(val);
+            for (int j = first; j < buffer.size(); ++j) {
+                m_visiblePoints << QPointF(timeAxis ? rowSeconds(buffer.x(j)) : buffer.x(j), buffer.y(j));
+            }
         }
+        m_lines[i]->replace(m_visiblePoints);
     }
+    // the times of rows no longer held by any line aren't needed anymore
+    m_times.discardBefore(oldestX);
+}
+
+inline void PlotterView::trackPending(const qreal val) {
+    if (m_dirty) {
+        if (val < m_pendingMin) m_pendingMin = val;
+        if (val > m_pendingMax) m_pendingMax = val;
+    } else {
+        m_pendingMin = val;
+        m_pendingMax = val;
+        m_dirty = true;
+    }
+}
+
+inline void PlotterView::scheduleRefresh() {
+    // at most one refresh per interval, however much data arrives in between
+    if (m_dirty && !m_refreshTimer.isActive()) {
+        m_refreshTimer.start();
+    }
+}
+
+void PlotterView::refresh() {
+    if (!m_dirty) return;
+    m_dirty = false;
+
+    // adjust the chart when values are out of range
+    const bool aboveMax = m_pendingMax > m_axisY->max();
+    const bool belowMin = m_pendingMin < m_axisY->min();
+    if (ui->bestFitRadio->isChecked()) {
+        if (aboveMax || belowMin) bestFit();
+    } else {
+        if (aboveMax) yMaxSelect(m_pendingMax);
+        if (belowMin) yMinSelect(m_pendingMin);
+    }
+    updateLegend();
+    updateSeries();
+    trackLatency();
+}
+
+inline void PlotterView::trackLatency() {
+    qint64 now = -1;
+    for (Source& source : m_sources) {
+        if (source.pendingTime < 0) continue;
+        if (now < 0) now = MonotonicClock::now();
+        // the oldest row drawn by this refresh waited the longest
+        source.stats->addLatency(now - source.pendingTime);
+        source.pendingTime = -1;
+    }
+}
+
+void PlotterView::plotPoint(const qreal val, const int lineIndex, const bool increment) {
+    ensureSource(0);
+    appendSample(val, 0, lineIndex);
+    trackPending(val);
     if (increment) {
-        for (int i = 0; i < m_lines.length(); ++i) {
-            auto line = m_lines[i];
-            if (m_linesLastX[i] != m_currX) {
-                m_linesLastX[i] = m_currX;
-                line->append(m_currX, 0);
-                line->setName("0");
+        endRow(0, MonotonicClock::now());
+    }
+    scheduleRefresh();
+}
+
+void PlotterView::plotFrame(const SampleFrame& frame) {
+    ensureSource(frame.source);
+    // rows that weren't stamped when they were read are stamped now
+    const qint64 now = frame.rowTimes.size() < frame.rowCount() ? MonotonicClock::now() : 0;
+    Source& source = m_sources[frame.source];
+    if (source.stats != nullptr && frame.rowCount() > 0) {
+        source.stats->addFramePlotted(frame.values.size());
+        if (source.pendingTime < 0) {
+            source.pendingTime = frame.rowTimes.isEmpty() ? now : frame.rowTimes.first();
+        }
+    }
+    const bool named = !frame.channels.isEmpty();
+    if (named) {
+        source.channelNames = frame.channelNames;
+    }
+    int rowStart = 0;
+    for (int row = 0; row < frame.rowCount(); ++row) {
+        const int rowEnd = frame.rowEnds[row];
+        for (int i = rowStart; i < rowEnd; ++i) {
+            const qreal val = frame.values[i];
+            if (named && frame.channels[i] >= 0) {
+                appendNamedSample(val, frame.source, frame.channels[i]);
+            } else {
+                appendSample(val, frame.source, i - rowStart);
             }
+            trackPending(val);
         }
-        ++m_currX;
+        // channels by position missing from this row are plotted at 0,
+        // unless it has none of them, which come before any named ones
+        endRow(frame.source, row < frame.rowTimes.size() ? frame.rowTimes[row] : now,
+               named && rowEnd > rowStart && frame.channels[rowStart] >= 0);
+        rowStart = rowEnd;
     }
+    // the chart itself is only touched on the next refresh
+    scheduleRefresh();
+}
+
+int PlotterView::addSource(const QString& name) {
+    Source source;
+    source.name = name;
+    m_sources << source;
+    return m_sources.length() - 1;
+}
+
+void PlotterView::setSourceName(const int source, const QString& name) {
+    ensureSource(source);
+    m_sources[source].name = name;
+    updateLegend();
+}
+
+void PlotterView::setSourceStats(const int source, PipelineStats* stats) {
+    ensureSource(source);
+    m_sources[source].stats = stats;
+    m_sources[source].pendingTime = -1;
 }
 
 PlotterView::~PlotterView() {
@@ -15,6 +15,13 @@
 #include <QDialog>
 #include <QtCharts>
 #include <QVector>
+#include <QTimer>
+#include "sampleframe.h"
+#include "pipelinestats.h"
+#include "samplebuffer.h"
+#include "timebuffer.h"
+#include "decimator.h"
+#include "windowextremes.h"
 
 using namespace QtCharts;
 
@@ -44,7 +51,7 @@ public:
 
 public slots:
     /**
-     * Plots the given value on the chart
+     * Plots the given value on the chart, on a line of the first source
      *
      * @param val y-value of the point to plot
      * @param lineIndex index of the line to plot the point on
@@ -52,18 +59,92 @@ public slots:
      */
     void plotPoint(const qreal val, const int lineIndex, const bool increment);
 
+    /**
+     * Plots every row of the given frame on the chart in one pass
+     *
+     * The number at position i in a row is plotted on channel i of the frame's source,
+     * unless the frame gives it a named channel, and currX is incremented after each row
+     *
+     * @param frame the rows to plot
+     */
+    void plotFrame(const SampleFrame& frame);
+
+    /**
+     * Registers a new source of frames, such as a port, with its own set of channels
+     *
+     * Sources don't keep an x of their own, rows of all sources share the
+     * x-axis as one global row index, in the order they arrive, or by time with the time axis
+     *
+     * @param name the name of the source, shown in the legend when there is more than one
+     * @return the id to put in the frames of the source
+     */
+    int addSource(const QString& name);
+
+    /**
+     * Renames a source
+     *
+     * @param source the id of the source
+     * @param name the new name of the source
+     */
+    void setSourceName(const int source, const QString& name);
+
+    /**
+     * Sets the counters that frames of a source and their latency are added to
+     *
+     * @param source the id of the source
+     * @param stats the counters, or nullptr to count nothing
+     */
+    void setSourceStats(const int source, PipelineStats* stats);
+
     /**
      * Clears the chart
      */
     void clear();
 
+    /**
+     * Applies everything plotted since the last refresh to the chart: axes, legend and series
+     *
+     * Called by the refresh timer at most once per interval, does nothing when there is no new data
+     */
+    void refresh();
+
     /**
      * Handles changes to the x-axis range
      *
      * @param xRange the new x-axis range
      */
     void handleChangeXRange(const int xRange);
+
+    /**
+     * Handles changes to the x-axis range of the time axis
+     *
+     * @param timeRange the new range in seconds
+     */
+    void handleChangeTimeRange(const double timeRange);
+
+    /**
+     * Switches the x-axis between row numbers and the times the rows were read
+     *
+     * @param checked whether to use the time axis
+     */
+    void handleTimeAxisToggled(const bool checked);
+
+    /**
+     * Handles changes to the number of samples kept for each line
+     *
+     * @param history the new number of samples
+     */
+    void handleChangeHistory(const int history);
+
+    /**
+     * Handles changes to the maximum number of chart refreshes per second
+     *
+     * @param refreshRate the new refresh rate in Hz
+     */
+    void handleChangeRefreshRate(const int refreshRate);
 private:
+    friend class PlotterViewTest;
+
     /**
      * The chart view Qt widget which lets us draw line graphs
      */
@@ -85,14 +166,55 @@ private:
     QValueAxis* m_axisY;
 
     /**
-     * The list of line series
+     * A source of frames, the lines of its channels, and the counters of its pipeline
+     *
+     * lines are the lines of the channels by position, namedLines the lines of the named channels
+     * by their id in channelNames, -1 for a named channel without a line.
+     * pendingTime is the read time of the oldest row not yet drawn, or -1 if there is none
+     */
+    struct Source {
+        QString name;
+        QVector<int> lines;
+        QVector<int> namedLines;
+        QStringList channelNames;
+        PipelineStats* stats = nullptr;
+        qint64 pendingTime = -1;
+    };
+
+    /**
+     * The sources of frames, indexed by id
+     */
+    QVector<Source> m_sources;
+
+    /**
+     * The source each line belongs to
+     */
+    QVector<int> m_lineSources;
+
+    /**
+     * The id of the named channel each line plots, or -1 for a line of a channel by position
+     */
+    QVector<int> m_lineChannels;
+
+    /**
+     * The list of line series, which only ever hold the visible window
      */
     QVector<QLineSeries*> m_lines;
 
     /**
-     * The x value at which each line starts
+     * The samples of each line, the source of truth for plotted data
+     */
+    QVector<SampleBuffer> m_buffers;
+
+    /**
+     * Min/max buckets of each line, used instead of the samples once there are more than the pixels to draw them
      */
-    QVector<int> m_linesStart;
+    QVector<MinMaxDecimator> m_decimators;
+
+    /**
+     * Minimum and maximum of each line over the visible window, kept up to date as samples arrive
+     */
+    QVector<WindowExtremes> m_extremes;
 
     /**
      * The last plotted x-value of the given line
@@ -100,10 +222,43 @@ private:
     QVector<int> m_linesLastX;
 
     /**
-     * The current x-value
+     * Scratch space for the visible points of a line, reused between updates
+     */
+    QVector<QPointF> m_visiblePoints;
+
+    /**
+     * The current x-value, a row index shared by all sources
+     *
+     * Every row of every source takes the next x, so a line only has samples
+     * at the rows of its own source and is drawn straight across the others
      */
     int m_currX;
 
+    /**
+     * The time of every row before currX still held by a line, in ns of MonotonicClock
+     */
+    TimeBuffer m_times;
+
+    /**
+     * Whether samples were plotted since the last refresh
+     */
+    bool m_dirty;
+
+    /**
+     * The smallest value plotted since the last refresh
+     */
+    qreal m_pendingMin;
+
+    /**
+     * The largest value plotted since the last refresh
+     */
+    qreal m_pendingMax;
+
+    /**
+     * Coalesces chart updates to at most one per display frame
+     */
+    QTimer m_refreshTimer;
+
     /**
      * Takes the visible portion of the graph,
      * and tries to fit it as snugly as possible within the given margins
@@ -111,11 +266,100 @@ private:
     void bestFit();
 
     /**
-     * Helper function to create and configure a new QLineSeries
+     * Recomputes the extremes of every line from its samples in the visible window
+     */
+    void rebuildExtremes();
+
+    /**
+     * @return the first x-value of the visible window, which covers the x-axis range in rows or in seconds
+     */
+    int windowStart() const;
+
+    /**
+     * @return the time of the row with the given x-value in seconds, for the time axis
+     */
+    inline qreal rowSeconds(const int x) const;
+
+    /**
+     * Helper function to create and configure a new QLineSeries for a channel of a source
      *
+     * @param source the id of the source
+     * @param namedChannel the id of the named channel, or -1 for the next channel by position
      * @return pointer to the newly allocated QLineSeries
      */
-    inline QLineSeries* createLine();
+    inline QLineSeries* createLine(const int source, const int namedChannel = -1);
+
+    /**
+     * Makes sure there is a source with the given id
+     */
+    inline void ensureSource(const int source);
+
+    /**
+     * Appends a sample at currX to the line of the given channel, creating it and any skipped channels as needed
+     *
+     * Skipped channels start at 0
+     *
+     * @param val y-value of the sample
+     * @param source the id of the source, which must exist
+     * @param channel index of the channel within the source
+     */
+    inline void appendSample(const qreal val, const int source, const int channel);
+
+    /**
+     * Appends a sample at currX to the line of the given named channel, creating it as needed
+     *
+     * Unlike channels by position, no other line is created, and rows without the channel add no point,
+     * so the line runs straight from the row before to the row after
+     *
+     * @param val y-value of the sample
+     * @param source the id of the source, which must exist
+     * @param channel the id of the named channel
+     */
+    inline void appendNamedSample(const qreal val, const int source, const int channel);
+
+    /**
+     * Stores a sample of the given line in its buffer, decimator and extremes
+     */
+    inline void storeSample(const int lineIndex, const int x, const qreal y);
+
+    /**
+     * Plots 0 on every line of a channel by position of the source without a sample at currX, then increments currX
+     *
+     * @param source the id of the source, which must exist
+     * @param time the time the row was read, in ns of MonotonicClock
+     * @param named whether the row only had named channels, which leaves the lines by position alone
+     */
+    inline void endRow(const int source, const qint64 time, const bool named = false);
+
+    /**
+     * Marks the chart dirty and keeps track of the extremes plotted since the last refresh
+     *
+     * @param val the plotted value
+     */
+    inline void trackPending(const qreal val);
+
+    /**
+     * Starts the refresh timer if there is new data and it isn't already running
+     */
+    inline void scheduleRefresh();
+
+    /**
+     * Counts the latency of the oldest row of every source drawn by a refresh
+     */
+    inline void trackLatency();
+
+    /**
+     * Names each line after its channel when it is named, or else after its newest value,
+     * prefixed with its source when there is more than one
+     */
+    void updateLegend();
+
+    /**
+     * Scrolls the x-axis to the newest samples and hands the visible window of each line to its series
+     *
+     * When the window has more samples than the plot has pixels, only the decimated points are handed over
+     */
+    void updateSeries();
 
     /**
      * Given a minimum limit of the graph, calculates and sets a range [x, y],
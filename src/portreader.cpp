@@ -0,0 +1,117 @@
+/**
+ * @file portreader.cpp
+ * @brief Implementation of PortReader class
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#include "portreader.h"
+#include "monotonicclock.h"
+
+// input kept in the port while reading is stopped, the OS buffers the rest or holds off the board
+#define PAUSEDBUFFERSIZE 4096
+
+PortReader::PortReader() :
+    m_serialPort(this),
+    m_reading(false),
+    m_readFirstPass(true),
+    m_recorder(nullptr),
+    m_stats(nullptr),
+    m_queue(nullptr),
+    m_paused(false) {
+
+    qRegisterMetaType<QSerialPort::SerialPortError>("QSerialPort::SerialPortError");
+    qRegisterMetaType<CaptureWriter*>("CaptureWriter*");
+    connect(&m_serialPort, &QSerialPort::readyRead, this, &PortReader::handleReadyRead);
+    connect(&m_serialPort, &QSerialPort::errorOccurred, this, &PortReader::handleError);
+}
+
+void PortReader::setPortName(const QString& name) {
+    m_serialPort.setPortName(name);
+}
+
+void PortReader::setBaudRate(const qint32 baudRate) {
+    m_serialPort.setBaudRate(baudRate);
+}
+
+void PortReader::open() {
+    if (tryOpen()) {
+        m_readFirstPass = true;
+        m_reading = true;
+    }
+}
+
+void PortReader::close() {
+    m_reading = false;
+    if (m_paused) {
+        m_paused = false;
+        m_serialPort.setReadBufferSize(0);
+    }
+    if (m_serialPort.isOpen()) {
+        m_serialPort.close();
+    }
+}
+
+void PortReader::write(const QByteArray& buf) {
+    if (tryOpen()) {
+        m_serialPort.write(buf);
+        if (!m_serialPort.error()) {
+            emit written();
+        }
+    }
+}
+
+void PortReader::setRecorder(CaptureWriter* recorder) {
+    m_recorder = recorder;
+}
+
+void PortReader::resume() {
+    if (!m_paused) return;
+    m_paused = false;
+    m_serialPort.setReadBufferSize(0);
+    // readyRead isn't emitted again for the input that is already waiting
+    if (m_serialPort.bytesAvailable() > 0) {
+        handleReadyRead();
+    }
+}
+
+void PortReader::handleReadyRead() {
+    // the first pass generally has corrupted data, so clear the serial port's buffer,
+    // same when the port was only opened to send
+    if (!m_reading || m_readFirstPass) {
+        m_readFirstPass = false;
+        m_serialPort.clear(QSerialPort::Input);
+        return;
+    }
+    // the input stays in the port until the window catches up
+    if (m_queue != nullptr && m_queue->isFull()) {
+        if (!m_paused) {
+            m_paused = true;
+            m_serialPort.setReadBufferSize(PAUSEDBUFFERSIZE);
+        }
+        return;
+    }
+    QByteArray buf = m_serialPort.readAll();
+    const qint64 time = MonotonicClock::now();
+    if (buf.length() > 0) {
+        if (m_recorder != nullptr) {
+            m_recorder->record(buf);
+        }
+        if (m_stats != nullptr) {
+            m_stats->addBytesRead(buf.size());
+        }
+        emit dataRead(buf, time);
+    }
+}
+
+void PortReader::handleError(QSerialPort::SerialPortError err) {
+    if (err != QSerialPort::NoError) {
+        emit errorOccurred(err);
+    }
+}
+
+inline bool PortReader::tryOpen() {
+    return m_serialPort.isOpen() || m_serialPort.open(QIODevice::ReadWrite);
+}
@@ -0,0 +1,175 @@
+/**
+ * @file portreader.h
+ * @brief PortReader class for serial port I/O in a separate thread
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#ifndef PORTREADER_H
+#define PORTREADER_H
+
+#include <QObject>
+#include <QtSerialPort/QSerialPort>
+#include "capturewriter.h"
+#include "pipelinestats.h"
+#include "outputqueue.h"
+
+class PortReader : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * Default constructor, takes no arguments
+     */
+    PortReader();
+
+    /**
+     * Describes the last error of the serial port, only call from the reader's thread
+     *
+     * @return human readable description of the error
+     */
+    QString errorString() const { return m_serialPort.errorString(); }
+
+    /**
+     * Sets the counters the reader adds to, call before the reader is moved to its thread
+     *
+     * @param stats the counters, or nullptr to count nothing
+     */
+    void setStats(PipelineStats* stats) { m_stats = stats; }
+
+    /**
+     * Sets the queue to the window, reading stops while it is full and blocks the reader
+     *
+     * Call before the reader is moved to its thread
+     *
+     * @param queue the queue, or nullptr to always read
+     */
+    void setOutputQueue(OutputQueue* queue) { m_queue = queue; }
+
+signals:
+    /**
+     * Sends the newly read input buffer to the worker for processing
+     *
+     * @param buf the input buffer
+     * @param time when the buffer was read, in ns of MonotonicClock
+     */
+    void dataRead(const QByteArray& buf, const qint64 time);
+
+    /**
+     * Forwards serial port errors to the main thread
+     *
+     * @param err the error enum which corresponds to the error
+     */
+    void errorOccurred(QSerialPort::SerialPortError err);
+
+    /**
+     * Emitted when a buffer was written to the port without errors
+     */
+    void written();
+
+public slots:
+    /**
+     * Sets the port to use, takes effect the next time the port is opened
+     *
+     * @param name the name of the port
+     */
+    void setPortName(const QString& name);
+
+    /**
+     * Sets the baud rate, also applies to an open port
+     *
+     * @param baudRate the new baud rate
+     */
+    void setBaudRate(const qint32 baudRate);
+
+    /**
+     * Opens the serial port if not already open, and starts reading from it
+     */
+    void open();
+
+    /**
+     * Stops reading from the serial port and closes it if open
+     */
+    void close();
+
+    /**
+     * Writes the buffer to the board, opening the port if not already open
+     *
+     * @param buf the buffer to write
+     */
+    void write(const QByteArray& buf);
+
+    /**
+     * Sets the capture that every buffer read is recorded to
+     *
+     * @param recorder the capture, or nullptr to stop recording
+     */
+    void setRecorder(CaptureWriter* recorder);
+
+    /**
+     * Reads again after the output queue was drained, if reading was stopped
+     */
+    void resume();
+
+private slots:
+    /**
+     * Reads new data from the port when available and sends it to the worker
+     */
+    void handleReadyRead();
+
+    /**
+     * Forwards actual errors of the serial port, ignoring it being cleared
+     *
+     * @param err the error enum which corresponds to the error
+     */
+    void handleError(QSerialPort::SerialPortError err);
+
+private:
+    /**
+     * Serial port object for serial communication, lives in the same thread as the reader
+     */
+    QSerialPort m_serialPort;
+
+    /**
+     * Whether input is being read and sent to the worker
+     */
+    bool m_reading;
+
+    /**
+     * Whether or not this is the first read after we started listening
+     *
+     * Used to clear the buffer, which may have old, corrupted data
+     */
+    bool m_readFirstPass;
+
+    /**
+     * Capture that input is recorded to, not owned by the reader
+     */
+    CaptureWriter* m_recorder;
+
+    /**
+     * Counters of the pipeline, not owned by the reader
+     */
+    PipelineStats* m_stats;
+
+    /**
+     * Queue to the window, not owned by the reader
+     */
+    OutputQueue* m_queue;
+
+    /**
+     * Whether reading stopped because the output queue was full
+     */
+    bool m_paused;
+
+    /**
+     * Opens the serial port if not already open
+     *
+     * @return whether the port is open without any errors
+     */
+    inline bool tryOpen();
+};
+
+#endif // PORTREADER_H
@@ -0,0 +1,181 @@
+/**
+ * @file rowview.cpp
+ * @brief Implementation of RowView class
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#include "rowview.h"
+#include <QApplication>
+#include <QClipboard>
+#include <QContextMenuEvent>
+#include <QFontDatabase>
+#include <QKeyEvent>
+#include <QMenu>
+#include <QMouseEvent>
+#include <QScrollBar>
+#include <climits>
+
+RowView::RowView(QWidget* parent) :
+    QAbstractScrollArea(parent),
+    m_anchorRow(-1),
+    m_cursorRow(-1) {
+    setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    setFocusPolicy(Qt::StrongFocus);
+}
+
+bool RowView::isRowSelected(const int row) const {
+    return hasSelection() && row >= qMin(m_anchorRow, m_cursorRow) && row <= qMax(m_anchorRow, m_cursorRow);
+}
+
+QString RowView::selectedText() const {
+    if (!hasSelection()) return QString();
+    const int last = qMax(m_anchorRow, m_cursorRow);
+    QString text;
+    for (int row = qMin(m_anchorRow, m_cursorRow); row <= last; ++row) {
+        text += rowText(row);
+        if (row < last) text += '\n';
+    }
+    return text;
+}
+
+void RowView::scrollToBottom() {
+    verticalScrollBar()->setValue(verticalScrollBar()->maximum());
+}
+
+void RowView::copy() {
+    if (hasSelection()) {
+        QApplication::clipboard()->setText(selectedText());
+    }
+}
+
+void RowView::selectAll() {
+    if (rowCount() == 0) return;
+    m_anchorRow = 0;
+    m_cursorRow = rowCount() - 1;
+    viewport()->update();
+}
+
+void RowView::clearSelection() {
+    m_anchorRow = -1;
+    m_cursorRow = -1;
+    viewport()->update();
+}
+
+void RowView::resizeEvent(QResizeEvent* event) {
+    QAbstractScrollArea::resizeEvent(event);
+    updateScrollBars();
+}
+
+void RowView::mousePressEvent(QMouseEvent* event) {
+    if (event->button() != Qt::LeftButton || rowCount() == 0) {
+        QAbstractScrollArea::mousePressEvent(event);
+        return;
+    }
+    selectTo(rowAt(event->pos().y()), event->modifiers() & Qt::ShiftModifier);
+}
+
+void RowView::mouseMoveEvent(QMouseEvent* event) {
+    if (!(event->buttons() & Qt::LeftButton) || !hasSelection()) {
+        QAbstractScrollArea::mouseMoveEvent(event);
+        return;
+    }
+    // dragging past the top or bottom scrolls along with the selection
+    selectTo(rowAt(event->pos().y()), true);
+}
+
+void RowView::keyPressEvent(QKeyEvent* event) {
+    if (event->matches(QKeySequence::Copy)) {
+        copy();
+    } else if (event->matches(QKeySequence::SelectAll)) {
+        selectAll();
+    } else if (event->modifiers() == Qt::ShiftModifier && rowCount() > 0) {
+        const int from = hasSelection() ? m_cursorRow : verticalScrollBar()->value();
+        const int page = verticalScrollBar()->pageStep();
+        switch (event->key()) {
+        case Qt::Key_Up:
+            selectTo(from - 1, hasSelection());
+            break;
+        case Qt::Key_Down:
+            selectTo(from + 1, hasSelection());
+            break;
+        case Qt::Key_PageUp:
+            selectTo(from - page, hasSelection());
+            break;
+        case Qt::Key_PageDown:
+            selectTo(from + page, hasSelection());
+            break;
+        default:
+            QAbstractScrollArea::keyPressEvent(event);
+        }
+    } else {
+        QAbstractScrollArea::keyPressEvent(event);
+    }
+}
+
+void RowView::contextMenuEvent(QContextMenuEvent* event) {
+    QMenu menu(this);
+    addMenuActions(menu);
+    menu.exec(event->globalPos());
+}
+
+void RowView::addMenuActions(QMenu& menu) {
+    menu.addAction("Copy", this, &RowView::copy)->setEnabled(hasSelection());
+    menu.addAction("Select All", this, &RowView::selectAll)->setEnabled(rowCount() > 0);
+}
+
+int RowView::rowX() const {
+    return ROWMARGIN - horizontalScrollBar()->value();
+}
+
+void RowView::updateScrollBars(const int droppedRows) {
+    const QFontMetrics metrics = fontMetrics();
+    QScrollBar* vertical = verticalScrollBar();
+    const int value = vertical->value();
+    const int visibleRows = qMax(1, viewport()->height() / metrics.height());
+    vertical->setPageStep(visibleRows);
+    vertical->setRange(0, qMax(0, rowCount() - visibleRows));
+    // the same rows stay in view while older ones are dropped above them
+    vertical->setValue(value - droppedRows);
+
+    if (hasSelection()) {
+        // and so does the selection, as far as any of its rows are left
+        const int last = qMin(qMax(m_anchorRow, m_cursorRow) - droppedRows, rowCount() - 1);
+        if (last < 0) {
+            m_anchorRow = -1;
+            m_cursorRow = -1;
+        } else {
+            m_anchorRow = qBound(0, m_anchorRow - droppedRows, last);
+            m_cursorRow = qBound(0, m_cursorRow - droppedRows, last);
+        }
+    }
+
+    QScrollBar* horizontal = horizontalScrollBar();
+    const qint64 rowWidth = 2 * ROWMARGIN + qint64(metrics.averageCharWidth()) * rowLength();
+    horizontal->setPageStep(viewport()->width());
+    horizontal->setRange(0, int(qBound(qint64(0), rowWidth - viewport()->width(), qint64(INT_MAX / 2))));
+}
+
+int RowView::rowAt(const int y) const {
+    const int lineHeight = fontMetrics().height();
+    // rounds towards the row above for y < 0
+    const int offset = y >= 0 ? y / lineHeight : (y - lineHeight + 1) / lineHeight;
+    return qBound(0, verticalScrollBar()->value() + offset, rowCount() - 1);
+}
+
+void RowView::selectTo(const int row, const bool extend) {
+    const int bounded = qBound(0, row, rowCount() - 1);
+    if (!extend || !hasSelection()) {
+        m_anchorRow = bounded;
+    }
+    m_cursorRow = bounded;
+    QScrollBar* vertical = verticalScrollBar();
+    if (bounded < vertical->value()) {
+        vertical->setValue(bounded);
+    } else if (bounded >= vertical->value() + vertical->pageStep()) {
+        vertical->setValue(bounded - vertical->pageStep() + 1);
+    }
+    viewport()->update();
+}
@@ -0,0 +1,142 @@
+/**
+ * @file rowview.h
+ * @brief Base of the monitor views that paint rows of monospaced text themselves
+ *
+ * Keeps the scroll bars in step with the rows, so a view only has to say how many
+ * rows there are and how long the longest one is. Rows are selected with the mouse,
+ * or with Shift and the arrow keys, and copied as text.
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#ifndef ROWVIEW_H
+#define ROWVIEW_H
+
+#include <QAbstractScrollArea>
+
+class QMenu;
+
+// space left of the rows, in pixels
+#define ROWMARGIN 4
+
+class RowView : public QAbstractScrollArea
+{
+    Q_OBJECT
+public:
+    /**
+     * Constructs a view in the system's fixed-width font
+     *
+     * @param parent the parent widget
+     */
+    explicit RowView(QWidget* parent = nullptr);
+
+    /**
+     * @return the number of rows that can be scrolled through
+     */
+    virtual int rowCount() const = 0;
+
+    /**
+     * @return whether any rows are selected
+     */
+    bool hasSelection() const { return m_anchorRow >= 0; }
+
+    /**
+     * @param row index of the row
+     * @return whether the row is selected
+     */
+    bool isRowSelected(const int row) const;
+
+    /**
+     * @return the selected rows as they are shown, one per line
+     */
+    QString selectedText() const;
+
+public slots:
+    /**
+     * Scrolls to the newest row
+     */
+    void scrollToBottom();
+
+    /**
+     * Copies the selected rows to the clipboard
+     */
+    void copy();
+
+    /**
+     * Selects every row kept
+     */
+    void selectAll();
+
+    /**
+     * Deselects all rows
+     */
+    void clearSelection();
+
+protected:
+    void resizeEvent(QResizeEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void keyPressEvent(QKeyEvent* event) override;
+    void contextMenuEvent(QContextMenuEvent* event) override;
+
+    /**
+     * @return the number of characters of the longest row
+     */
+    virtual qint64 rowLength() const = 0;
+
+    /**
+     * @param row index of the row
+     * @return the whole row as it is shown, for copying
+     */
+    virtual QString rowText(const int row) const = 0;
+
+    /**
+     * Adds the actions of the context menu, views add their own after these
+     *
+     * @param menu the menu
+     */
+    virtual void addMenuActions(QMenu& menu);
+
+    /**
+     * @return the x-coordinate in the viewport where the rows start
+     */
+    int rowX() const;
+
+    /**
+     * Updates the ranges of the scroll bars to the rows and the size of the viewport
+     *
+     * The selection stays on its rows while older ones are dropped above them.
+     *
+     * @param droppedRows the number of rows dropped from the top since the last update
+     */
+    void updateScrollBars(const int droppedRows = 0);
+
+private:
+    /**
+     * The row the selection was started from, or -1 when nothing is selected
+     */
+    int m_anchorRow;
+
+    /**
+     * The row the selection was extended to, on the other end from `m_anchorRow`
+     */
+    int m_cursorRow;
+
+    /**
+     * @param y the y-coordinate in the viewport
+     * @return the row at y, or the nearest one when y is past the first or last row
+     */
+    int rowAt(const int y) const;
+
+    /**
+     * Moves the end of the selection to the row, scrolling it into view
+     *
+     * @param row index of the row
+     * @param extend whether the selection is extended, instead of starting over at the row
+     */
+    void selectTo(const int row, const bool extend);
+};
+
+#endif // ROWVIEW_H
@@ -0,0 +1,52 @@
+/**
+ * @file samplebuffer.cpp
+ * @brief Implementation of SampleBuffer class
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#include "samplebuffer.h"
+
+SampleBuffer::SampleBuffer(const int capacity) :
+    m_capacity(qMax(capacity, 1)),
+    m_start(0) {}
+
+void SampleBuffer::setCapacity(const int capacity) {
+    const int newCapacity = qMax(capacity, 1);
+    if (newCapacity == m_capacity) return;
+    const int kept = qMin(size(), newCapacity);
+    QVector<int> xs;
+    QVector<qreal> ys;
+    xs.reserve(kept);
+    ys.reserve(kept);
+    for (int i = size() - kept; i < size(); ++i) {
+        xs.append(x(i));
+        ys.append(y(i));
+    }
+    m_x = xs;
+    m_y = ys;
+    m_capacity = newCapacity;
+    m_start = 0;
+}
+
+int SampleBuffer::lowerBound(const int x) const {
+    int low = 0;
+    int high = size();
+    while (low < high) {
+        const int mid = low + (high - low) / 2;
+        if (this->x(mid) < x) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+void SampleBuffer::clear() {
+    m_x.clear();
+    m_y.clear();
+    m_start = 0;
+}
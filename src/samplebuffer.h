@@ -0,0 +1,118 @@
+/**
+ * @file samplebuffer.h
+ * @brief Fixed-capacity ring buffer holding the samples of one line of the plotter
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#ifndef SAMPLEBUFFER_H
+#define SAMPLEBUFFER_H
+
+#include <QVector>
+
+class SampleBuffer {
+public:
+    /**
+     * Constructs an empty buffer
+     *
+     * @param capacity the maximum number of samples kept, older ones are overwritten
+     */
+    explicit SampleBuffer(const int capacity = 1);
+
+    /**
+     * Changes the capacity, keeping the newest samples that still fit
+     *
+     * @param capacity the new capacity
+     */
+    void setCapacity(const int capacity);
+
+    /**
+     * @return the maximum number of samples kept
+     */
+    int capacity() const { return m_capacity; }
+
+    /**
+     * @return the number of samples currently held
+     */
+    int size() const { return m_x.size(); }
+
+    /**
+     * Appends a sample, overwriting the oldest one when full
+     *
+     * x-values must be appended in ascending order
+     *
+     * @param x the x-value of the sample
+     * @param y the y-value of the sample
+     */
+    inline void append(const int x, const qreal y);
+
+    /**
+     * @param i index of the sample, 0 being the oldest
+     * @return the x-value of the sample
+     */
+    int x(const int i) const { return m_x[physical(i)]; }
+
+    /**
+     * @param i index of the sample, 0 being the oldest
+     * @return the y-value of the sample
+     */
+    qreal y(const int i) const { return m_y[physical(i)]; }
+
+    /**
+     * Binary searches for the first sample with an x-value of at least x
+     *
+     * @param x the x-value to search for
+     * @return the index of the sample, or size() if there is none
+     */
+    int lowerBound(const int x) const;
+
+    /**
+     * Removes all samples, keeping the capacity
+     */
+    void clear();
+
+private:
+    /**
+     * x-values of the samples, stored apart from the y-values so scans stay cache friendly
+     */
+    QVector<int> m_x;
+
+    /**
+     * y-values of the samples
+     */
+    QVector<qreal> m_y;
+
+    /**
+     * The maximum number of samples kept
+     */
+    int m_capacity;
+
+    /**
+     * Position of the oldest sample in the arrays, only non-zero once the buffer is full
+     */
+    int m_start;
+
+    /**
+     * Maps the index of a sample to its position in the arrays
+     */
+    int physical(const int i) const {
+        const int p = m_start + i;
+        return p >= m_x.size() ? p - m_x.size() : p;
+    }
+};
+
+inline void SampleBuffer::append(const int x, const qreal y) {
+    if (m_x.size() < m_capacity) {
+        // the arrays grow until the capacity is reached
+        m_x.append(x);
+        m_y.append(y);
+    } else {
+        m_x[m_start] = x;
+        m_y[m_start] = y;
+        if (++m_start == m_capacity) m_start = 0;
+    }
+}
+
+#endif // SAMPLEBUFFER_H
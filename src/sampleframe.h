@@ -0,0 +1,60 @@
+/**
+ * @file sampleframe.h
+ * @brief Block of parsed rows handed from the worker to the plotter in one go
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#ifndef SAMPLEFRAME_H
+#define SAMPLEFRAME_H
+
+#include <QMetaType>
+#include <QStringList>
+#include <QVector>
+
+struct SampleFrame {
+    /**
+     * The plotter source the rows belong to, see PlotterView::addSource
+     */
+    int source = 0;
+
+    /**
+     * The numbers of every row, stored one row after the other
+     */
+    QVector<qreal> values;
+
+    /**
+     * For every row, the index one past its last number in `values`
+     */
+    QVector<int> rowEnds;
+
+    /**
+     * For every row, the time its last byte was read, in ns of MonotonicClock
+     *
+     * May be empty, in which case the rows are stamped when they are plotted
+     */
+    QVector<qint64> rowTimes;
+
+    /**
+     * For every number, the id of its named channel, or -1 for a number plotted by its position
+     *
+     * Empty when no row of the frame has named channels
+     */
+    QVector<int> channels;
+
+    /**
+     * The names of the named channels by id, set along with `channels`
+     */
+    QStringList channelNames;
+
+    /**
+     * @return the number of rows in the frame
+     */
+    int rowCount() const { return rowEnds.size(); }
+};
+
+Q_DECLARE_METATYPE(SampleFrame)
+
+#endif // SAMPLEFRAME_H
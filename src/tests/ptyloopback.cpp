@@ -0,0 +1,99 @@
+#include "ptyloopback.h"
+#ifdef Q_OS_UNIX
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+PtyLoopback::PtyLoopback() :
+    m_master(-1),
+    m_written(0),
+    m_burstSize(0) {
+    connect(&m_timer, &QTimer::timeout, this, &PtyLoopback::writeBurst);
+}
+
+PtyLoopback::~PtyLoopback() {
+#ifdef Q_OS_UNIX
+    if (m_master >= 0) {
+        ::close(m_master);
+    }
+#endif
+}
+
+bool PtyLoopback::open() {
+#ifdef Q_OS_UNIX
+    m_master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (m_master < 0) return false;
+    if (grantpt(m_master) != 0 || unlockpt(m_master) != 0) return false;
+    const char* name = ptsname(m_master);
+    if (name == nullptr) return false;
+    m_portName = QString::fromLocal8Bit(name);
+    // the port configures the slave itself, but data may arrive before it does,
+    // and a cooked slave would echo it back or translate line endings
+    const int slave = ::open(name, O_RDWR | O_NOCTTY);
+    if (slave < 0) return false;
+    termios attributes;
+    const bool raw = tcgetattr(slave, &attributes) == 0 &&
+            (cfmakeraw(&attributes), tcsetattr(slave, TCSANOW, &attributes) == 0);
+    ::close(slave);
+    return raw && fcntl(m_master, F_SETFL, fcntl(m_master, F_GETFL) | O_NONBLOCK) == 0;
+#else
+    return false;
+#endif
+}
+
+void PtyLoopback::pump(const QByteArray& data, const int burstSize, const int interval) {
+    m_pending = m_pending.mid(m_written) + data;
+    m_written = 0;
+    m_burstSize = burstSize;
+    m_timer.start(interval);
+}
+
+void PtyLoopback::writeBurst() {
+#ifdef Q_OS_UNIX
+    const int size = qMin(m_burstSize, m_pending.size() - m_written);
+    const ssize_t written = ::write(m_master, m_pending.constData() + m_written, size_t(size));
+    // a full pty buffer is retried on the next tick
+    if (written > 0) {
+        m_written += int(written);
+    }
+#endif
+    if (isIdle()) {
+        m_timer.stop();
+        emit pumped();
+    }
+}
+
+QByteArray PtyLoopback::readAll() {
+    QByteArray received;
+#ifdef Q_OS_UNIX
+    char buf[4096];
+    ssize_t length;
+    while ((length = ::read(m_master, buf, sizeof(buf))) > 0) {
+        received.append(buf, int(length));
+    }
+#endif
+    return received;
+}
+
+QByteArray PtyLoopback::lines(const int first, const int rows, const int columns) {
+    QByteArray data;
+    for (int row = first; row < first + rows; ++row) {
+        for (int column = 1; column <= columns; ++column) {
+            data.append(QByteArray::number(row * column)).append(column < columns ? ',' : '\n');
+        }
+    }
+    return data;
+}
+
+void PtyLoopback::corrupt(QByteArray& data, const qreal probability, const quint32 seed) {
+    quint32 state = seed;
+    for (int i = 0; i < data.size(); ++i) {
+        state = state * 1103515245 + 12345;
+        if ((state >> 8) % 1000000 < probability * 1000000) {
+            data[i] = char(data[i] ^ (1 << (state % 8)));
+        }
+    }
+}
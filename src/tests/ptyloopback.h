@@ -0,0 +1,80 @@
+#ifndef PTYLOOPBACK_H
+#define PTYLOOPBACK_H
+#include <QObject>
+#include <QTimer>
+
+/**
+ * A pseudo-terminal pair standing in for a board, the slave side is opened as the serial port
+ *
+ * Traffic is written to the master side from the thread the loopback lives in,
+ * in bursts of a given size at a given interval. Only available on Unix.
+ */
+class PtyLoopback : public QObject {
+    Q_OBJECT
+public:
+    PtyLoopback();
+    ~PtyLoopback();
+
+    /**
+     * Creates the pty pair and puts the slave side in raw mode
+     *
+     * @return whether the pair was created
+     */
+    bool open();
+
+    /**
+     * @return the path of the slave side, to be used as the port name
+     */
+    QString portName() const { return m_portName; }
+
+    /**
+     * Queues data to be written to the port
+     *
+     * @param data the bytes to write
+     * @param burstSize the number of bytes written at once
+     * @param interval the time between bursts in ms, 0 to write as fast as the pty accepts
+     */
+    void pump(const QByteArray& data, const int burstSize, const int interval);
+
+    /**
+     * @return whether all queued data has been written
+     */
+    bool isIdle() const { return m_written == m_pending.size(); }
+
+    /**
+     * Reads what was written to the port so far
+     */
+    QByteArray readAll();
+
+    /**
+     * Builds rows of comma separated integers, the row index times the column number
+     */
+    static QByteArray lines(const int first, const int rows, const int columns);
+
+    /**
+     * Flips random bits of random bytes
+     *
+     * @param probability the probability of a byte being changed
+     * @param seed the seed of the random number generator, so failures are reproducible
+     */
+    static void corrupt(QByteArray& data, const qreal probability, const quint32 seed);
+
+signals:
+    /**
+     * Emitted when all queued data has been written
+     */
+    void pumped();
+
+private slots:
+    void writeBurst();
+
+private:
+    int m_master;
+    QString m_portName;
+    QByteArray m_pending;
+    int m_written;
+    int m_burstSize;
+    QTimer m_timer;
+};
+
+#endif // PTYLOOPBACK_H
@@ -1,5 +1,8 @@
 #include "test.h"
+#include <QMouseEvent>
 #include <QScrollBar>
+#include <QtEndian>
+#include "captureformat.h"
 
 void WorkerTest::processDataTest() {
     Worker worker;
@@ -9,10 +12,1138 @@ void WorkerTest::processDataTest() {
     QCOMPARE(outputSpy.count(), 1);
 
     worker.plotEnabled = true;
-    QSignalSpy plotPointSpy(&worker, &Worker::plotPoint);
+    QSignalSpy plotFrameSpy(&worker, &Worker::plotFrame);
     buf = QString("Hello bro 1.23 2.34 3.45 4.56\r\n").toUtf8();
     worker.processData(buf);
-    QCOMPARE(plotPointSpy.count(), 4); // four points
+    QCOMPARE(plotFrameSpy.count(), 1);
+    SampleFrame frame = plotFrameSpy[0][0].value<SampleFrame>();
+    QCOMPARE(frame.rowCount(), 1);
+    QCOMPARE(frame.values.length(), 4); // four points
+
+    // a line broken up into separate packets
+    plotFrameSpy.clear();
+    worker.processData(QString("5, 6").toUtf8());
+    QCOMPARE(plotFrameSpy.count(), 0);
+    worker.processData(QString("\t7\n8 9\n").toUtf8());
+    QCOMPARE(plotFrameSpy.count(), 1); // one frame for both rows
+    frame = plotFrameSpy[0][0].value<SampleFrame>();
+    QCOMPARE(frame.values, (QVector<qreal>{5, 6, 7, 8, 9}));
+    QCOMPARE(frame.rowEnds, (QVector<int>{3, 5}));
+}
+
+void WorkerTest::timestampTest() {
+    Worker worker;
+    worker.plotEnabled = true;
+    QSignalSpy plotFrameSpy(&worker, &Worker::plotFrame);
+    // the first buffer has nothing to interpolate from, so all its rows get its read time
+    worker.processData("1\n2\n", 1000000);
+    QCOMPARE(plotFrameSpy[0][0].value<SampleFrame>().rowTimes, (QVector<qint64>{1000000, 1000000}));
+
+    // rows are spread over the time since the previous buffer, by where they end in the buffer
+    worker.processData("3\n4\n", 2000000);
+    QCOMPARE(plotFrameSpy[1][0].value<SampleFrame>().rowTimes, (QVector<qint64>{1500000, 2000000}));
+
+    // after an idle period, the bytes can't have arrived faster than the baud rate, 1 ms per byte here
+    worker.setBaudRate(10000);
+    worker.processData("5\n6\n", 1002000000);
+    QCOMPARE(plotFrameSpy[2][0].value<SampleFrame>().rowTimes, (QVector<qint64>{1000000000, 1002000000}));
+}
+
+void WorkerTest::statsTest() {
+    PipelineStats stats;
+    Worker worker;
+    worker.setStats(&stats);
+    worker.plotEnabled = true;
+    worker.processData("1 2\nnoise\n3\n");
+    const PipelineStats::Snapshot snapshot = stats.snapshot();
+    QCOMPARE(snapshot.bytesProcessed, qint64(12));
+    QCOMPARE(snapshot.rowsParsed, qint64(2));
+    QCOMPARE(snapshot.rowsRejected, qint64(1));
+    QCOMPARE(snapshot.framesQueued, qint64(1));
+    QCOMPARE(snapshot.textQueued, qint64(12));
+    // reading is counted by the reader, showing the text by the window
+    QCOMPARE(snapshot.bytesRead, qint64(0));
+}
+
+void WorkerTest::monitorModeTest() {
+    Worker worker;
+    QSignalSpy outputSpy(&worker, &Worker::output);
+    // a character split across buffers comes out whole, once it is complete
+    const QByteArray euro = QString::fromUtf8("\u20AC").toUtf8();
+    worker.processData("a" + euro.left(1));
+    worker.processData(euro.mid(1, 1));
+    worker.processData(euro.mid(2) + "b");
+    QCOMPARE(outputSpy.count(), 2);
+    QCOMPARE(outputSpy[0][0].toString(), QString("a"));
+    QCOMPARE(outputSpy[1][0].toString(), QString::fromUtf8("\u20ACb"));
+
+    // nothing is decoded while the monitor is paused or off, but the plotter still gets its rows
+    outputSpy.clear();
+    worker.plotEnabled = true;
+    QSignalSpy plotFrameSpy(&worker, &Worker::plotFrame);
+    worker.setMonitorMode(Worker::MonitorPaused);
+    worker.processData("1\n");
+    worker.setMonitorMode(Worker::MonitorOff);
+    worker.processData("2\n" + euro.left(2));
+    QCOMPARE(outputSpy.count(), 0);
+    QCOMPARE(plotFrameSpy.count(), 2);
+
+    // the rest of a character whose start wasn't decoded is skipped
+    worker.setMonitorMode(Worker::MonitorLive);
+    worker.processData(euro.mid(2) + "c");
+    QCOMPARE(outputSpy.count(), 1);
+    QCOMPARE(outputSpy[0][0].toString(), QString("c"));
+
+    // a byte order mark reaching a fresh decoder is passed on, not taken as a header
+    outputSpy.clear();
+    worker.setMonitorMode(Worker::MonitorOff);
+    worker.setMonitorMode(Worker::MonitorLive);
+    worker.processData("\xEF\xBB\xBF" "d");
+    QCOMPARE(outputSpy.count(), 1);
+    QCOMPARE(outputSpy[0][0].toString(), QString(QChar(0xFEFF)) + "d");
+}
+
+typedef QVector<qreal> RealVector;
+typedef QVector<int> IntVector;
+
+void LineParserTest::feedTest_data() {
+    QTest::addColumn<QByteArray>("input");
+    QTest::addColumn<RealVector>("values");
+    QTest::addColumn<IntVector>("rowEnds");
+
+    QTest::newRow("single") << QByteArray("42\n") << RealVector{42} << IntVector{1};
+    QTest::newRow("crlf") << QByteArray("1,2\r\n") << RealVector{1, 2} << IntVector{2};
+    QTest::newRow("separators") << QByteArray("-1.5 ,\t2\n3\n") << RealVector{-1.5, 2, 3} << IntVector{2, 3};
+    QTest::newRow("prefix") << QByteArray("Hello bro 1.23 4\n") << RealVector{1.23, 4} << IntVector{2};
+    QTest::newRow("inside word") << QByteArray("x12 3\n") << RealVector{12, 3} << IntVector{2};
+    QTest::newRow("two points") << QByteArray("1.2.3 4\n") << RealVector{2.3, 4} << IntVector{2};
+    QTest::newRow("minus inside") << QByteArray("5-3\n") << RealVector{-3} << IntVector{1};
+    QTest::newRow("invalid middle") << QByteArray("1 a 2\n") << RealVector{2} << IntVector{1};
+    QTest::newRow("trailing separator") << QByteArray("1 2 \n") << RealVector{} << IntVector{};
+    QTest::newRow("trailing text") << QByteArray("1 2x\n") << RealVector{} << IntVector{};
+    QTest::newRow("bare point") << QByteArray("1.\n") << RealVector{} << IntVector{};
+    QTest::newRow("two carriage returns") << QByteArray("1\r\r\n") << RealVector{} << IntVector{};
+    QTest::newRow("no newline") << QByteArray("1 2") << RealVector{} << IntVector{};
+    QTest::newRow("long number") << QByteArray("123456789012345678901234\n") << RealVector{123456789012345678901234.0} << IntVector{1};
+    QTest::newRow("counts") << QByteArray("0,1023,-512,9007199254740993\n") << RealVector{0, 1023, -512, 9007199254740993.0} << IntVector{4};
+    QTest::newRow("rounding") << QByteArray("0.1 2.675 1.7976931348623157e308\n") << RealVector{0.1, 2.675, 1.7976931348623157e308} << IntVector{3};
+    QTest::newRow("exponent") << QByteArray("1e3 -2.5E-3 4e+2 5e30\n") << RealVector{1e3, -2.5e-3, 4e2, 5e30} << IntVector{4};
+    QTest::newRow("exponent suffix") << QByteArray("x1.5e2 e5 1.e5\n") << RealVector{5} << IntVector{1};
+    QTest::newRow("bare exponent") << QByteArray("1e\n") << RealVector{} << IntVector{};
+    QTest::newRow("overflow") << QByteArray("1 1e999\n") << RealVector{} << IntVector{};
+}
+
+void LineParserTest::feedTest() {
+    QFETCH(QByteArray, input);
+    QFETCH(RealVector, values);
+    QFETCH(IntVector, rowEnds);
+
+    LineParser parser;
+    RealVector parsedValues;
+    IntVector parsedRowEnds;
+    parser.feed(input, parsedValues, parsedRowEnds);
+    QCOMPARE(parsedValues, values);
+    QCOMPARE(parsedRowEnds, rowEnds);
+}
+
+void LineParserTest::splitLineTest() {
+    // feeding one byte at a time must give the same result as feeding everything at once
+    const QByteArray input("0.5 -2\r\nnoise\n7,8,9\n");
+    LineParser parser;
+    RealVector values;
+    IntVector rowEnds;
+    for (int i = 0; i < input.size(); ++i) {
+        parser.feed(input.mid(i, 1), values, rowEnds);
+    }
+    QCOMPARE(values, (RealVector{0.5, -2, 7, 8, 9}));
+    QCOMPARE(rowEnds, (IntVector{2, 5}));
+
+    // a partial line is dropped by reset
+    values.clear();
+    rowEnds.clear();
+    parser.feed("1 2", values, rowEnds);
+    parser.reset();
+    parser.feed("3\n", values, rowEnds);
+    QCOMPARE(values, RealVector{3});
+}
+
+void LineParserTest::namedTest_data() {
+    QTest::addColumn<QByteArray>("input");
+    QTest::addColumn<RealVector>("values");
+    QTest::addColumn<IntVector>("channels");
+    QTest::addColumn<QStringList>("names");
+
+    QTest::newRow("positional") << QByteArray("1,2\n") << RealVector{1, 2} << IntVector{} << QStringList{};
+    QTest::newRow("named") << QByteArray("temp=21.5,volt:3.3\n") << RealVector{21.5, 3.3} << IntVector{0, 1}
+                           << QStringList{"temp", "volt"};
+    // a name needs its value right after it, or else it is a label before the list
+    QTest::newRow("label") << QByteArray("temp: 21.5\r\n") << RealVector{21.5} << IntVector{} << QStringList{};
+    QTest::newRow("label of one") << QByteArray("ADC: 512\n") << RealVector{512} << IntVector{} << QStringList{};
+    QTest::newRow("label of many") << QByteArray("Sensor: 1 2 3\n") << RealVector{1, 2, 3} << IntVector{}
+                                   << QStringList{};
+    QTest::newRow("same ids") << QByteArray("a=1\nb=2,a=3\n") << RealVector{1, 2, 3} << IntVector{0, 1, 0}
+                              << QStringList{"a", "b"};
+    QTest::newRow("repeated name") << QByteArray("a=1 a=2 b=3\n") << RealVector{1, 3} << IntVector{0, 1}
+                                   << QStringList{"a", "b"};
+    QTest::newRow("mixed rows") << QByteArray("1,2\nx=5\n3\n") << RealVector{1, 2, 5, 3} << IntVector{-1, -1, 0, -1}
+                                << QStringList{"x"};
+    // fields don't break up the list, and come after it
+    QTest::newRow("list and fields") << QByteArray("id 7 x=5 8\n") << RealVector{7, 8, 5} << IntVector{-1, -1, 0}
+                                     << QStringList{"x"};
+    QTest::newRow("invalid in list") << QByteArray("7 x=5 ok 8\n") << RealVector{8, 5} << IntVector{-1, 0}
+                                     << QStringList{"x"};
+    QTest::newRow("other tokens") << QByteArray("id 7 x=5 8 ok\n") << RealVector{5} << IntVector{0}
+                                  << QStringList{"x"};
+    QTest::newRow("no value") << QByteArray("x=\n") << RealVector{} << IntVector{} << QStringList{};
+    QTest::newRow("invalid value") << QByteArray("x=abc 5\n") << RealVector{5} << IntVector{} << QStringList{};
+    QTest::newRow("not a name") << QByteArray("1.x=4\n") << RealVector{4} << IntVector{} << QStringList{};
+}
+
+void LineParserTest::namedTest() {
+    QFETCH(QByteArray, input);
+    QFETCH(RealVector, values);
+    QFETCH(IntVector, channels);
+    QFETCH(QStringList, names);
+
+    LineParser parser;
+    RealVector parsedValues;
+    IntVector parsedRowEnds;
+    IntVector parsedChannels;
+    parser.feed(input, parsedValues, parsedRowEnds, nullptr, &parsedChannels);
+    QCOMPARE(parsedValues, values);
+    QCOMPARE(parsedChannels, channels);
+    QCOMPARE(parser.channelNames(), names);
+}
+
+void ChannelTableTest::internTest() {
+    ChannelTable table;
+    QCOMPARE(table.intern("temp", 4), 0);
+    QCOMPARE(table.intern("volt", 4), 1);
+    QCOMPARE(table.intern("temperature", 4), 0);
+    QCOMPARE(table.names(), (QStringList{"temp", "volt"}));
+
+    // ids stay the same as the table grows, until it is full
+    for (int i = 2; i < 1100; ++i) {
+        const QByteArray name = "c" + QByteArray::number(i);
+        QCOMPARE(table.intern(name.constData(), name.size()), i < 1024 ? i : -1);
+    }
+    QCOMPARE(table.size(), 1024);
+    QCOMPARE(table.intern("volt", 4), 1);
+    QCOMPARE(table.intern("c1023", 5), 1023);
+}
+
+void DelimiterScannerTest::kernelsTest() {
+    // every length up to a few words, so each kernel's vector loop and tail are covered
+    QByteArray input;
+    for (int i = 0; i < 200; ++i) {
+        input.append("12,-3.5 \t\r\nx"[(i * 7 + i / 13) % 12]);
+    }
+    const DelimiterScanner::Kernel best = DelimiterScanner::kernel();
+    for (int length = 0; length <= input.size(); ++length) {
+        const int words = (length + 63) / 64;
+        // stale bits past the end must be cleared
+        QVector<quint64> newlines(words, ~quint64(0));
+        QVector<quint64> separators(words, ~quint64(0));
+        DelimiterScanner::setKernel(DelimiterScanner::Scalar);
+        DelimiterScanner::scan(input.constData(), length, newlines.data(), separators.data());
+        for (int i = 0; i < words * 64; ++i) {
+            const char c = i < length ? input[i] : '\0';
+            QCOMPARE(bool((newlines[i / 64] >> (i % 64)) & 1), c == '\n');
+            QCOMPARE(bool((separators[i / 64] >> (i % 64)) & 1), c == ',' || c == ' ' || c == '\t');
+        }
+        for (const DelimiterScanner::Kernel kernel : {DelimiterScanner::Sse2, DelimiterScanner::Avx2}) {
+            if (!DelimiterScanner::isSupported(kernel)) continue;
+            DelimiterScanner::setKernel(kernel);
+            QVector<quint64> vectorNewlines(words, ~quint64(0));
+            QVector<quint64> vectorSeparators(words, ~quint64(0));
+            DelimiterScanner::scan(input.constData(), length, vectorNewlines.data(), vectorSeparators.data());
+            QCOMPARE(vectorNewlines, newlines);
+            QCOMPARE(vectorSeparators, separators);
+        }
+    }
+    DelimiterScanner::setKernel(best);
+    QCOMPARE(DelimiterScanner::kernel(), DelimiterScanner::bestKernel());
+}
+
+namespace {
+
+QByteArray framePayload(const FrameDecoder::ValueType type, const QByteArray& values, const int count) {
+    QByteArray payload;
+    payload.append(char(type)).append(char(count)).append(values);
+    const quint16 crc = FrameDecoder::crc16(payload.constData(), payload.size());
+    payload.append(char(crc & 0xFF)).append(char(crc >> 8));
+    return payload;
+}
+
+QByteArray cobsEncode(const QByteArray& payload) {
+    QByteArray encoded("\x01", 1);
+    int code = 0;
+    for (const char c : payload) {
+        if (c != '\0') {
+            encoded.append(c);
+            encoded[code] = char(encoded[code] + 1);
+        }
+        if (c == '\0' || quint8(encoded[code]) == 0xFF) {
+            code = encoded.size();
+            encoded.append('\x01');
+        }
+    }
+    return encoded.append('\0');
+}
+
+QByteArray slipEncode(const QByteArray& payload) {
+    QByteArray encoded;
+    for (const char c : payload) {
+        if (c == '\xC0') {
+            encoded.append("\xDB\xDC", 2);
+        } else if (c == '\xDB') {
+            encoded.append("\xDB\xDD", 2);
+        } else {
+            encoded.append(c);
+        }
+    }
+    return encoded.append('\xC0');
+}
+
+}
+
+void FrameDecoderTest::cobsTest() {
+    // the check value of CRC-16/CCITT-FALSE
+    QCOMPARE(FrameDecoder::crc16("123456789", 9), quint16(0x29B1));
+
+    const QByteArray int16s = framePayload(FrameDecoder::Int16, QByteArray("\x01\x00\xFF\xFF", 4), 2);
+    const QByteArray int32s = framePayload(FrameDecoder::Int32, QByteArray("\x00\x01\x00\x00", 4), 1);
+    const QByteArray floats = framePayload(FrameDecoder::Float32, QByteArray("\x00\x00\xC0\x3F", 4), 1);
+    QByteArray stream = cobsEncode(int16s) + cobsEncode(int32s) + cobsEncode(floats);
+
+    FrameDecoder decoder;
+    RealVector values;
+    IntVector rowEnds;
+    // a frame broken up into separate packets is completed later
+    decoder.feed(stream.left(5), values, rowEnds);
+    decoder.feed(stream.mid(5), values, rowEnds);
+    QCOMPARE(values, (RealVector{1, -1, 256, 1.5}));
+    QCOMPARE(rowEnds, (IntVector{2, 3, 4}));
+    QCOMPARE(decoder.errorCount(), qint64(0));
+
+    // a corrupt byte only loses the frame it is in
+    const int corrupt = cobsEncode(int16s).size() + 3;
+    stream[corrupt] = char(stream[corrupt] ^ 0x10);
+    values.clear();
+    rowEnds.clear();
+    decoder.feed(stream, values, rowEnds);
+    QCOMPARE(values, (RealVector{1, -1, 1.5}));
+    QCOMPARE(rowEnds, (IntVector{2, 3}));
+    QCOMPARE(decoder.errorCount(), qint64(1));
+}
+
+void FrameDecoderTest::slipTest() {
+    // 0xC0 and 0xDB inside the frame must be escaped
+    const QByteArray payload = framePayload(FrameDecoder::Int16, QByteArray("\xC0\x00\xDB\x00", 4), 2);
+    FrameDecoder decoder(FrameDecoder::Slip);
+    RealVector values;
+    IntVector rowEnds;
+    // senders often start with a delimiter to flush line noise
+    const QByteArray stream = QByteArray("\xC0", 1) + slipEncode(payload);
+    for (int i = 0; i < stream.size(); ++i) {
+        decoder.feed(stream.mid(i, 1), values, rowEnds);
+    }
+    QCOMPARE(values, (RealVector{192, 219}));
+    QCOMPARE(rowEnds, IntVector{2});
+    QCOMPARE(decoder.errorCount(), qint64(0));
+
+    // an invalid escape drops the frame, decoding resumes at the next delimiter
+    values.clear();
+    rowEnds.clear();
+    decoder.feed(QByteArray("\x01\xDB\x02\xC0", 4) + slipEncode(payload), values, rowEnds);
+    QCOMPARE(rowEnds, IntVector{2});
+    QCOMPARE(decoder.errorCount(), qint64(1));
+}
+
+void PortReaderTest::openErrorTest() {
+    PortReader reader;
+    QSignalSpy errorSpy(&reader, &PortReader::errorOccurred);
+    QSignalSpy dataSpy(&reader, &PortReader::dataRead);
+    reader.setPortName("wserial-no-such-port");
+    reader.open();
+    // the error is forwarded instead of being handled by the reader
+    QCOMPARE(errorSpy.count(), 1);
+    reader.write("hello");
+    QCOMPARE(errorSpy.count(), 2);
+    reader.close();
+    QCOMPARE(dataSpy.count(), 0);
+}
+
+namespace {
+
+QByteArray captureHeader() {
+    QByteArray header(CAPTURE_MAGIC, CAPTURE_MAGICSIZE);
+    return header.append(QByteArray(CAPTURE_HEADERSIZE - CAPTURE_MAGICSIZE, '\0'));
+}
+
+QByteArray captureChunk(const qint64 time, const QByteArray& data) {
+    QByteArray chunk(CAPTURE_CHUNKHEADERSIZE, '\0');
+    qToLittleEndian<qint64>(time, chunk.data());
+    qToLittleEndian<quint32>(quint32(data.size()), chunk.data() + 8);
+    return chunk.append(data);
+}
+
+bool writeFile(const QString& path, const QByteArray& contents) {
+    QFile file(path);
+    return file.open(QIODevice::WriteOnly) && file.write(contents) == contents.size();
+}
+
+}
+
+void CaptureWriterTest::fileFormatTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("test.wcap");
+    CaptureWriter writer;
+    QVERIFY(writer.open(path));
+    writer.record("hello");
+    // large enough to be handed over before the capture is closed
+    const QByteArray big(300 * 1024, 'x');
+    writer.record(big);
+    QCoreApplication::processEvents();
+    writer.record("bye");
+    writer.close();
+
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray capture = file.readAll();
+    const char* data = capture.constData();
+    QCOMPARE(capture.left(CAPTURE_MAGICSIZE), QByteArray(CAPTURE_MAGIC));
+
+    // the chunks follow the header in order, with ascending times
+    const QByteArray chunks[] = {"hello", big, "bye"};
+    qint64 offset = CAPTURE_HEADERSIZE;
+    qint64 lastTime = 0;
+    for (const QByteArray& chunk : chunks) {
+        const qint64 time = qFromLittleEndian<qint64>(data + offset);
+        QVERIFY(time >= lastTime);
+        lastTime = time;
+        QCOMPARE(qFromLittleEndian<quint32>(data + offset + 8), quint32(chunk.size()));
+        QCOMPARE(capture.mid(offset + CAPTURE_CHUNKHEADERSIZE, chunk.size()), chunk);
+        offset += CAPTURE_CHUNKHEADERSIZE + chunk.size();
+    }
+
+    // the trailer locates the index, whose first block starts right after the header
+    const char* trailer = data + capture.size() - CAPTURE_TRAILERSIZE;
+    QCOMPARE(QByteArray(trailer + 12, CAPTURE_MAGICSIZE), QByteArray(CAPTURE_INDEXMAGIC));
+    QCOMPARE(qFromLittleEndian<qint64>(trailer), offset);
+    const quint32 entries = qFromLittleEndian<quint32>(trailer + 8);
+    QCOMPARE(entries, quint32(2));
+    QCOMPARE(qFromLittleEndian<qint64>(data + offset), qint64(CAPTURE_HEADERSIZE));
+    QCOMPARE(offset + entries * CAPTURE_INDEXENTRYSIZE + CAPTURE_TRAILERSIZE, qint64(capture.size()));
+
+    QSignalSpy errorSpy(&writer, &CaptureWriter::errorOccurred);
+    QVERIFY(!writer.open(dir.filePath("no/such/dir/test.wcap")));
+    QCOMPARE(errorSpy.count(), 1);
+}
+
+void CaptureWriterTest::stalledDiskTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    CaptureWriter writer;
+    QVERIFY(writer.open(dir.filePath("test.wcap")));
+    // without an event loop nothing is written, as if the disk had stalled
+    const QByteArray chunk(1024 * 1024, 'x');
+    for (int i = 0; i < 20; ++i) {
+        writer.record(chunk);
+    }
+    // the queued data stays bounded, the rest is counted
+    QCOMPARE(writer.droppedChunks(), qint64(5));
+    writer.close();
+    QCOMPARE(QFile(dir.filePath("test.wcap")).size(),
+             qint64(CAPTURE_HEADERSIZE + 15 * (CAPTURE_CHUNKHEADERSIZE + chunk.size())
+                    + CAPTURE_INDEXENTRYSIZE + CAPTURE_TRAILERSIZE));
+}
+
+void CapturePlayerTest::replayTest() {
+    QTemporaryDir dir;
+    const QString path = dir.filePath("test.wcap");
+    CaptureWriter writer;
+    QVERIFY(writer.open(path));
+    const QByteArray chunks[] = {"1 2\n3", " 4\n", QByteArray(100 * 1024, '5')};
+    for (const QByteArray& chunk : chunks) {
+        writer.record(chunk);
+    }
+    writer.close();
+
+    CapturePlayer player;
+    QSignalSpy dataSpy(&player, &CapturePlayer::dataRead);
+    QSignalSpy finishedSpy(&player, &CapturePlayer::finished);
+    player.play(path, 0);
+    QTRY_COMPARE(finishedSpy.count(), 1);
+    // chunks come out exactly as they were read from the port, and the index is skipped
+    QCOMPARE(dataSpy.count(), 3);
+    for (int i = 0; i < 3; ++i) {
+        QCOMPARE(dataSpy[i][0].toByteArray(), chunks[i]);
+    }
+    QCOMPARE(finishedSpy[0][0].toLongLong(), qint64(chunks[0].size() + chunks[1].size() + chunks[2].size()));
+
+    QSignalSpy errorSpy(&player, &CapturePlayer::errorOccurred);
+    QVERIFY(writeFile(path, "1 2 3\n"));
+    player.play(path, 0);
+    QCOMPARE(errorSpy.count(), 1);
+    QCOMPARE(finishedSpy.count(), 1);
+}
+
+void CapturePlayerTest::timingTest() {
+    // a capture that was never closed, with the last chunk cut off
+    QTemporaryDir dir;
+    const QString path = dir.filePath("test.wcap");
+    QVERIFY(writeFile(path, captureHeader() + captureChunk(1000, "a") + captureChunk(200001000, "b") +
+                      captureChunk(300001000, "cut off").left(CAPTURE_CHUNKHEADERSIZE + 3)));
+
+    CapturePlayer player;
+    QSignalSpy dataSpy(&player, &CapturePlayer::dataRead);
+    QSignalSpy finishedSpy(&player, &CapturePlayer::finished);
+    player.play(path, 1);
+    // the first chunk is due immediately, the second as long after it as it was recorded
+    QCOMPARE(dataSpy.count(), 1);
+    QTRY_COMPARE(finishedSpy.count(), 1);
+    QCOMPARE(dataSpy.count(), 2);
+    QVERIFY(finishedSpy[0][1].toLongLong() >= 200000000);
+
+    player.play(path, 4);
+    QTRY_COMPARE(finishedSpy.count(), 2);
+    QVERIFY(finishedSpy[1][1].toLongLong() >= 50000000);
+    QVERIFY(finishedSpy[1][1].toLongLong() < 200000000);
+}
+
+void HeadlessStreamerTest::csvTest() {
+    QBuffer out;
+    out.open(QIODevice::WriteOnly);
+    HeadlessStreamer streamer(&out, false);
+    streamer.processData("1 2.5\r\n-3,");
+    streamer.processData("4\nnoise\n0.1\t100000000000000000000\n");
+    QCOMPARE(out.data(), QByteArray("1,2.5\n-3,4\n0.1,1e+20\n"));
+}
+
+void HeadlessStreamerTest::rawTest() {
+    QBuffer out;
+    out.open(QIODevice::WriteOnly);
+    HeadlessStreamer streamer(&out, true);
+    streamer.processData("1 2");
+    streamer.processData("\nnoise\n");
+    QCOMPARE(out.data(), QByteArray("1 2\nnoise\n"));
+}
+
+void HeadlessStreamerTest::openErrorTest() {
+    QBuffer out;
+    out.open(QIODevice::WriteOnly);
+    HeadlessStreamer streamer(&out, false);
+    QSignalSpy failedSpy(&streamer, &HeadlessStreamer::failed);
+    streamer.start("wserial-no-such-port", 9600);
+    QCOMPARE(failedSpy.count(), 1);
+    QVERIFY(out.data().isEmpty());
+}
+
+namespace {
+
+/**
+ * A frame of the given rows of one value each
+ */
+SampleFrame singleValueRows(const QVector<qreal>& values) {
+    SampleFrame frame;
+    frame.values = values;
+    for (int i = 1; i <= values.size(); ++i) {
+        frame.rowEnds << i;
+        frame.rowTimes << i * 10;
+    }
+    return frame;
+}
+
+}
+
+void OutputQueueTest::dropOldestTest() {
+    OutputQueue queue;
+    PipelineStats stats;
+    queue.setStats(&stats);
+    queue.setCapacity(4, 5);
+    QSignalSpy availableSpy(&queue, &OutputQueue::dataAvailable);
+    queue.pushFrame(singleValueRows({1, 2}));
+    queue.pushFrame(singleValueRows({3, 4}));
+    queue.pushFrame(singleValueRows({5, 6}));
+    queue.pushText("abc");
+    queue.pushText("defg");
+    // one event for everything pushed until the queue is taken
+    QCOMPARE(availableSpy.count(), 1);
+    QVERIFY(!queue.isFull());
+
+    QString text;
+    QByteArray bytes;
+    QVector<SampleFrame> frames;
+    queue.take(text, bytes, frames);
+    QCOMPARE(text, QString("cdefg"));
+    QCOMPARE(frames.size(), 2);
+    QCOMPARE(frames[0].values, (QVector<qreal>{3, 4}));
+    QCOMPARE(queue.droppedSamples(), qint64(2));
+    QCOMPARE(queue.droppedCharacters(), qint64(2));
+    QCOMPARE(stats.snapshot().framesDropped, qint64(1));
+
+    queue.pushText("h");
+    QCOMPARE(availableSpy.count(), 2);
+
+    // bytes for the hex monitor are dropped the same way as text
+    queue.pushBytes("\x01\x02\x03");
+    queue.pushBytes("\x04\x05\x06");
+    text.clear();
+    queue.take(text, bytes, frames);
+    QCOMPARE(text, QString("h"));
+    QCOMPARE(bytes, QByteArray("\x02\x03\x04\x05\x06"));
+    QCOMPARE(queue.droppedCharacters(), qint64(3));
+}
+
+void OutputQueueTest::decimateTest() {
+    OutputQueue queue;
+    queue.setPolicy(OutputQueue::Decimate);
+    queue.setCapacity(4, 5);
+    queue.pushFrame(singleValueRows({1, 2, 3, 4, 5, 6, 7, 8}));
+
+    // every other row goes, the newest one stays
+    QString text;
+    QByteArray bytes;
+    QVector<SampleFrame> frames;
+    queue.take(text, bytes, frames);
+    QCOMPARE(frames.size(), 1);
+    QCOMPARE(frames[0].values, (QVector<qreal>{2, 4, 6, 8}));
+    QCOMPARE(frames[0].rowEnds, (QVector<int>{1, 2, 3, 4}));
+    QCOMPARE(frames[0].rowTimes, (QVector<qint64>{20, 40, 60, 80}));
+    QCOMPARE(queue.droppedSamples(), qint64(4));
+
+    // named channels stay with their numbers
+    SampleFrame named;
+    named.values = {1, 2, 3, 4, 5};
+    named.rowEnds = {2, 3, 5};
+    named.channels = {0, 1, -1, 1, 0};
+    queue.pushFrame(named);
+    frames.clear();
+    queue.take(text, bytes, frames);
+    QCOMPARE(frames[0].values, (QVector<qreal>{1, 2, 4, 5}));
+    QCOMPARE(frames[0].channels, (QVector<int>{0, 1, 1, 0}));
+
+    // single rows can't be thinned, so the oldest frames go
+    SampleFrame row;
+    row.values = {1, 2, 3};
+    row.rowEnds = {3};
+    queue.pushFrame(row);
+    row.values = {4, 5, 6};
+    queue.pushFrame(row);
+    frames.clear();
+    queue.take(text, bytes, frames);
+    QCOMPARE(frames.size(), 1);
+    QCOMPARE(frames[0].values, (QVector<qreal>{4, 5, 6}));
+}
+
+void OutputQueueTest::blockReaderTest() {
+    OutputQueue queue;
+    queue.setPolicy(OutputQueue::BlockReader);
+    queue.setCapacity(4, 5);
+    QSignalSpy drainedSpy(&queue, &OutputQueue::drained);
+    queue.pushFrame(singleValueRows({1, 2, 3}));
+    QVERIFY(!queue.isFull());
+    queue.pushFrame(singleValueRows({4, 5, 6}));
+    QVERIFY(queue.isFull());
+
+    // nothing is lost, the reader is told to read again once the queue is taken
+    QString text;
+    QByteArray bytes;
+    QVector<SampleFrame> frames;
+    queue.take(text, bytes, frames);
+    QCOMPARE(frames.size(), 2);
+    QCOMPARE(queue.droppedSamples(), qint64(0));
+    QVERIFY(!queue.isFull());
+    QCOMPARE(drainedSpy.count(), 1);
+
+    // or when the policy no longer blocks it
+    queue.pushText("abcdefg");
+    QVERIFY(queue.isFull());
+    queue.setPolicy(OutputQueue::DropOldest);
+    QVERIFY(!queue.isFull());
+    QCOMPARE(drainedSpy.count(), 2);
+}
+
+void PipelineStatsTest::summaryTest() {
+    PipelineStats stats;
+    const PipelineStats::Snapshot start = stats.snapshot();
+    QCOMPARE(start.latencyPercentile(start, 0.5), qint64(-1));
+
+    // percentiles are the upper bounds of power of two buckets of µs
+    for (int i = 0; i < 90; ++i) {
+        stats.addLatency(1500000);
+    }
+    for (int i = 0; i < 10; ++i) {
+        stats.addLatency(100000000);
+    }
+    stats.addBytesRead(1000);
+    stats.addBytesProcessed(600);
+    stats.addRows(5, 2);
+    stats.addFrameQueued();
+    stats.addFrameQueued();
+    stats.addFrameQueued();
+    stats.addFramePlotted(10);
+    stats.addTextQueued(50);
+    stats.addTextShown(20);
+    const PipelineStats::Snapshot snapshot = stats.snapshot();
+    QCOMPARE(snapshot.latencyPercentile(start, 0.5), qint64(2048000));
+    QCOMPARE(snapshot.latencyPercentile(start, 0.9), qint64(2048000));
+    QCOMPARE(snapshot.latencyPercentile(start, 0.99), qint64(131072000));
+    QCOMPARE(snapshot.samplesPlotted, qint64(10));
+
+    const QString summary = PipelineStats::summary(start, snapshot);
+    QVERIFY2(summary.contains("(2 rejected)"), qPrintable(summary));
+    QVERIFY2(summary.contains("queued 400 B, 2 frames, 30 chars"), qPrintable(summary));
+    QVERIFY2(summary.contains("(0 dropped)"), qPrintable(summary));
+    QVERIFY2(summary.contains("p50 2 ms, p90 2 ms, p99 131 ms"), qPrintable(summary));
+
+    // only what happened between the snapshots counts
+    stats.addLatency(0);
+    QCOMPARE(stats.snapshot().latencyPercentile(snapshot, 0.99), qint64(1000));
+}
+
+void SampleBufferTest::ringTest() {
+    SampleBuffer buffer(3);
+    QCOMPARE(buffer.size(), 0);
+    QCOMPARE(buffer.lowerBound(0), 0);
+    for (int x = 0; x < 5; ++x) {
+        buffer.append(x, x * 10);
+    }
+    // only the newest three samples are kept, oldest first
+    QCOMPARE(buffer.size(), 3);
+    QCOMPARE(buffer.x(0), 2);
+    QCOMPARE(buffer.y(2), qreal(40));
+    QCOMPARE(buffer.lowerBound(3), 1);
+    QCOMPARE(buffer.lowerBound(100), 3);
+
+    buffer.setCapacity(2);
+    QCOMPARE(buffer.size(), 2);
+    QCOMPARE(buffer.x(0), 3);
+    buffer.setCapacity(4);
+    buffer.append(5, 50);
+    buffer.append(6, 60);
+    buffer.append(7, 70);
+    QCOMPARE(buffer.size(), 4);
+    QCOMPARE(buffer.x(0), 4);
+    QCOMPARE(buffer.y(3), qreal(70));
+
+    buffer.clear();
+    QCOMPARE(buffer.size(), 0);
+    QCOMPARE(buffer.capacity(), 4);
+}
+
+void ByteRingTest::ringTest() {
+    ByteRing ring(4);
+    ring.append("ab", 2);
+    ring.append("cdef", 4);
+    // only the newest four bytes are kept, and offsets count the whole stream
+    QCOMPARE(ring.size(), 4);
+    QCOMPARE(ring.startOffset(), qint64(2));
+    QCOMPARE(ring.endOffset(), qint64(6));
+    char out[8];
+    ring.copy(2, 4, out);
+    QCOMPARE(QByteArray(out, 4), QByteArray("cdef"));
+    // a copy across the end of the wrapped data
+    ring.append("g", 1);
+    ring.copy(4, 3, out);
+    QCOMPARE(QByteArray(out, 3), QByteArray("efg"));
+
+    // more than the capacity at once keeps its newest bytes
+    ring.append("hijklm", 6);
+    ring.copy(ring.startOffset(), ring.size(), out);
+    QCOMPARE(QByteArray(out, 4), QByteArray("jklm"));
+
+    ring.setCapacity(2);
+    QCOMPARE(ring.startOffset(), qint64(11));
+    ring.copy(11, 2, out);
+    QCOMPARE(QByteArray(out, 2), QByteArray("lm"));
+
+    ring.clear();
+    QCOMPARE(ring.size(), 0);
+    QCOMPARE(ring.startOffset(), qint64(13));
+}
+
+void LineStoreTest::linesTest() {
+    LineStore store(10);
+    QCOMPARE(store.lineCount(), 0);
+    // a line broken up into separate appends
+    store.append("ab", 2);
+    QCOMPARE(store.lineCount(), 1);
+    store.append("c\r\nde\n\nf", 8);
+    QCOMPARE(store.lineCount(), 4);
+    QCOMPARE(store.line(0), QByteArray("abc\r"));
+    QCOMPARE(store.line(1), QByteArray("de"));
+    QCOMPARE(store.line(2), QByteArray());
+    QCOMPARE(store.line(3), QByteArray("f"));
+    QCOMPARE(store.longestLineLength(), 4);
+    // the line after a newline only starts with its first character
+    store.append("\n", 1);
+    QCOMPARE(store.lineCount(), 4);
+    QCOMPARE(store.line(3), QByteArray("f"));
+    QCOMPARE(store.text(), QByteArray("abc\r\nde\n\nf\n"));
+    store.append("g", 1);
+    QCOMPARE(store.lineCount(), 5);
+    QCOMPARE(store.lineLength(4), 1);
+}
+
+void LineStoreTest::trimTest() {
+    LineStore store(3);
+    for (int i = 0; i < 100; ++i) {
+        const QByteArray line = QByteArray::number(i) + '\n';
+        store.append(line.constData(), line.size());
+    }
+    // only the newest lines are kept, and the dropped ones are counted
+    QCOMPARE(store.lineCount(), 3);
+    QCOMPARE(store.droppedLineCount(), qint64(97));
+    QCOMPARE(store.line(0), QByteArray("97"));
+    QCOMPARE(store.text(), QByteArray("97\n98\n99\n"));
+
+    store.setMaximumLineCount(1);
+    QCOMPARE(store.text(), QByteArray("99\n"));
+    store.clear();
+    QCOMPARE(store.lineCount(), 0);
+    QCOMPARE(store.droppedLineCount(), qint64(100));
+    QCOMPARE(store.text(), QByteArray());
+}
+
+namespace {
+
+QVector<qint64> spiedMatches(const QSignalSpy& spy) {
+    QVector<qint64> lines;
+    for (const QList<QVariant>& arguments : spy) {
+        lines += arguments[1].value<QVector<qint64>>();
+    }
+    return lines;
+}
+
+}
+
+void LineSearcherTest::searchTest() {
+    LineStore store(100);
+    QReadWriteLock lock;
+    LineSearcher searcher(&store, &lock);
+    QSignalSpy matchesSpy(&searcher, &LineSearcher::matchesFound);
+    const QByteArray text = "temp=21\r\nvolt=3.3\ntemp=22\nerror: overheat\ntemp";
+    store.append(text.constData(), text.size());
+    searcher.setPattern(1, "temp", false);
+    // the unfinished last line isn't searched yet
+    QCOMPARE(matchesSpy.count(), 1);
+    QCOMPARE(matchesSpy[0][0].toInt(), 1);
+    QCOMPARE(spiedMatches(matchesSpy), (QVector<qint64>{0, 2}));
+
+    // only the new lines are searched
+    const QByteArray more = "=23\nvolt=3.2\n";
+    store.append(more.constData(), more.size());
+    searcher.scan();
+    QCOMPARE(spiedMatches(matchesSpy), (QVector<qint64>{0, 2, 4}));
+    searcher.scan();
+    QCOMPARE(matchesSpy.count(), 2);
+
+    // regular expressions match lines as shown, without the carriage return
+    matchesSpy.clear();
+    searcher.setPattern(2, "^temp=2[13]$", true);
+    QCOMPARE(matchesSpy[0][0].toInt(), 2);
+    QCOMPARE(spiedMatches(matchesSpy), (QVector<qint64>{0, 4}));
+
+    // and so does text
+    matchesSpy.clear();
+    searcher.setPattern(3, "21\r", false);
+    searcher.setPattern(4, "\r", false);
+    QCOMPARE(matchesSpy.count(), 0);
+    searcher.setPattern(5, "=2", false);
+    QCOMPARE(spiedMatches(matchesSpy), (QVector<qint64>{0, 2, 4}));
+
+    // nothing is searched for an empty or invalid pattern
+    matchesSpy.clear();
+    searcher.setPattern(6, "", false);
+    searcher.setPattern(7, "(", true);
+    QCOMPARE(matchesSpy.count(), 0);
+}
+
+void LineSearcherTest::chunksTest() {
+    LineStore store(1000000);
+    QReadWriteLock lock;
+    LineSearcher searcher(&store, &lock);
+    QSignalSpy matchesSpy(&searcher, &LineSearcher::matchesFound);
+    QByteArray text;
+    for (int i = 0; i < 100000; ++i) {
+        text += "line " + QByteArray::number(i) + '\n';
+    }
+    store.append(text.constData(), text.size());
+    // the first chunk is searched right away, the rest after other events
+    searcher.setPattern(1, "99", false);
+    QCOMPARE(matchesSpy.count(), 1);
+    const QVector<qint64> firstChunk = spiedMatches(matchesSpy);
+    store.setMaximumLineCount(50000);
+    QTRY_COMPARE(spiedMatches(matchesSpy).last(), qint64(99999));
+
+    // lines dropped before they were reached are skipped
+    QVector<qint64> expected;
+    for (qint64 line = 0; line < 100000; ++line) {
+        if ((line <= firstChunk.last() || line >= 50000) && QByteArray::number(line).contains("99")) {
+            expected.append(line);
+        }
+    }
+    QCOMPARE(spiedMatches(matchesSpy), expected);
+}
+
+void TimeBufferTest::blocksTest() {
+    TimeBuffer times;
+    QVERIFY(times.isEmpty());
+    QCOMPARE(times.lowerBound(0), 0);
+    // one row per ms, spanning three blocks
+    for (int x = 0; x < 10000; ++x) {
+        times.append(qint64(x) * 1000000);
+    }
+    QCOMPARE(times.firstX(), 0);
+    QCOMPARE(times.endX(), 10000);
+    QCOMPARE(times.at(0), qint64(0));
+    QCOMPARE(times.at(9999), qint64(9999000000));
+    QCOMPARE(times.lowerBound(2500500000), 2501);
+    QCOMPARE(times.lowerBound(20000000000), 10000);
+
+    // only whole blocks are dropped
+    times.discardBefore(5000);
+    QVERIFY(times.firstX() > 0 && times.firstX() <= 5000);
+    QCOMPARE(times.at(5000), qint64(5000000000));
+
+    // a gap too long for the offsets of a block, and a time before the last one
+    times.append(qint64(9999000000) + 10000000000000);
+    times.append(1000);
+    QCOMPARE(times.at(10000), qint64(10009999000000));
+    QCOMPARE(times.at(10001), qint64(10009999000000));
+    QCOMPARE(times.at(9999), qint64(9999000000));
+
+    // times are stored with µs resolution
+    times.clear();
+    QVERIFY(times.isEmpty());
+    times.append(1234567);
+    QCOMPARE(times.endX(), 1);
+    QCOMPARE(times.at(0), qint64(1234567));
+    times.append(1235678);
+    QCOMPARE(times.at(1), qint64(1235567));
+}
+
+void DecimatorTest::pointsTest() {
+    MinMaxDecimator decimator;
+    QVector<QPointF> points;
+    // disabled by default
+    decimator.append(0, 1);
+    decimator.points(points);
+    QCOMPARE(points.length(), 0);
+
+    decimator.setBucketWidth(10);
+    for (int x = 0; x < 1000; ++x) {
+        decimator.append(x, x == 537 ? 100 : x % 7);
+    }
+    decimator.points(points);
+    // at most two points per bucket, and the peak survives
+    QVERIFY(points.length() <= 200);
+    QVERIFY(points.contains(QPointF(537, 100)));
+    for (int i = 1; i < points.length(); ++i) {
+        QVERIFY(points[i].x() > points[i - 1].x());
+    }
+
+    points.clear();
+    decimator.discardBefore(995);
+    decimator.points(points);
+    QCOMPARE(points.length(), 2);
+    QCOMPARE(points.first().x(), qreal(993));
+}
+
+void WindowExtremesTest::slidingWindowTest() {
+    const int window = 50;
+    QVector<qreal> ys;
+    WindowExtremes extremes;
+    QVERIFY(extremes.isEmpty());
+    for (int x = 0; x < 5000; ++x) {
+        ys << qreal((x * 7919) % 1009);
+        extremes.append(x, ys.last());
+        extremes.discardBefore(x - window + 1);
+        // compare against a full scan of the window
+        qreal min = ys.last();
+        qreal max = ys.last();
+        for (int i = qMax(0, x - window + 1); i <= x; ++i) {
+            min = qMin(min, ys[i]);
+            max = qMax(max, ys[i]);
+        }
+        QCOMPARE(extremes.min(), min);
+        QCOMPARE(extremes.max(), max);
+    }
+    extremes.discardBefore(5000);
+    QVERIFY(extremes.isEmpty());
+}
+
+void HexViewTest::formatRowTest() {
+    const char data[] = "0,1.5\r\n\x00\xff" "abcdefg";
+    QCOMPARE(HexView::formatRow(0x10, data, 0, 16),
+             QString("00000010  30 2c 31 2e 35 0d 0a 00  ff 61 62 63 64 65 66 67  |0,1.5....abcdefg|"));
+    // the bytes outside the kept ones are left blank, without moving the columns
+    QCOMPARE(HexView::formatRow(0x123456780, data, 2, 4),
+             QString("123456780        31 2e                                       |  1.            |"));
+}
+
+void HexViewTest::scrollTest() {
+    HexView hexView;
+    hexView.resize(600, 200);
+    hexView.setMaximumRowCount(100);
+    hexView.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&hexView));
+    QScrollBar* scroller = hexView.verticalScrollBar();
+    hexView.append(QByteArray(50 * 16, 'x'));
+    QCOMPARE(hexView.rowCount(), 50);
+    QVERIFY(scroller->maximum() > 0);
+    scroller->setValue(10);
+
+    // the rows in view stay there while the oldest ones are dropped
+    hexView.append(QByteArray(60 * 16, 'y'));
+    QCOMPARE(hexView.rowCount(), 100);
+    QCOMPARE(hexView.bytes().startOffset(), qint64(10 * 16));
+    QCOMPARE(scroller->value(), 0);
+    hexView.scrollToBottom();
+    QCOMPARE(scroller->value(), scroller->maximum());
+    hexView.repaint();
+
+    hexView.clear();
+    QCOMPARE(hexView.rowCount(), 0);
+    QCOMPARE(scroller->maximum(), 0);
+    // the next row starts where the stream left off
+    hexView.append("z");
+    QCOMPARE(hexView.bytes().startOffset(), qint64(110 * 16));
+    // rows are copied as they are shown
+    hexView.selectAll();
+    QCOMPARE(hexView.selectedText(), HexView::formatRow(110 * 16, "z", 0, 1));
+}
+
+void LogViewTest::formatLineTest() {
+    // only the CR of a CRLF line ending is left out
+    QCOMPARE(LogView::formatLine("1,2\r", 4, 100), QString("1,2"));
+    QCOMPARE(LogView::formatLine("1\r2", 3, 100), QString("1\r2"));
+    QCOMPARE(LogView::formatLine("\r", 1, 100), QString());
+    // bytes past the viewport aren't decoded
+    QCOMPARE(LogView::formatLine("abcdef", 6, 3), QString("abc"));
+    QCOMPARE(LogView::formatLine("\xc2\xb0" "C", 3, 100), QString::fromUtf8("\xc2\xb0" "C"));
+}
+
+void LogViewTest::appendTest() {
+    LogView logView;
+    logView.resize(600, 200);
+    logView.setMaximumLineCount(5);
+    const LineStore& lines = logView.lines();
+
+    // the unfinished last line grows with the next append instead of starting a new row
+    logView.append("12");
+    QCOMPARE(logView.rowCount(), 1);
+    logView.append("34\r\n5");
+    QCOMPARE(logView.rowCount(), 2);
+    QCOMPARE(lines.line(0), QByteArray("1234\r"));
+    QCOMPARE(lines.line(1), QByteArray("5"));
+    logView.append(QString::fromUtf8("6\xc2\xb0\n"));
+    QCOMPARE(logView.rowCount(), 2);
+    QCOMPARE(lines.line(1), QByteArray("6\xc2\xb0"));
+    QCOMPARE(logView.toPlainText(), QString::fromUtf8("1234\r\n56\xc2\xb0\n"));
+
+    // only the newest lines are kept, and the scroll bar only spans those
+    logView.append("a\nb\nc\nd\ne\nf\ng\n");
+    QCOMPARE(logView.rowCount(), 5);
+    QCOMPARE(lines.droppedLineCount(), qint64(4));
+    QCOMPARE(logView.toPlainText(), QString("c\nd\ne\nf\ng\n"));
+    logView.setMaximumLineCount(2);
+    QCOMPARE(logView.toPlainText(), QString("f\ng\n"));
+    QCOMPARE(logView.verticalScrollBar()->maximum(), 0);
+
+    logView.clear();
+    QCOMPARE(logView.rowCount(), 0);
+    QCOMPARE(logView.toPlainText(), QString());
+}
+
+void LogViewTest::selectionTest() {
+    LogView logView;
+    logView.resize(600, 400);
+    logView.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&logView));
+    for (int i = 0; i < 10; ++i) {
+        logView.append(QString("line %1\r\n").arg(i));
+    }
+    QCOMPARE(logView.verticalScrollBar()->maximum(), 0);
+    const int lineHeight = logView.fontMetrics().height();
+    QVERIFY(!logView.hasSelection());
+
+    // dragging with the left button selects whole rows, copied without their CR
+    QTest::mousePress(logView.viewport(), Qt::LeftButton, Qt::NoModifier, QPoint(10, 2 * lineHeight + 1));
+    QMouseEvent drag(QEvent::MouseMove, QPoint(10, 4 * lineHeight + 1), Qt::NoButton, Qt::LeftButton, Qt::NoModifier);
+    QApplication::sendEvent(logView.viewport(), &drag);
+    QTest::mouseRelease(logView.viewport(), Qt::LeftButton, Qt::NoModifier, QPoint(10, 4 * lineHeight + 1));
+    QCOMPARE(logView.selectedText(), QString("line 2\nline 3\nline 4"));
+
+    // shift extends from where the selection was started
+    QTest::mousePress(logView.viewport(), Qt::LeftButton, Qt::ShiftModifier, QPoint(10, lineHeight + 1));
+    QCOMPARE(logView.selectedText(), QString("line 1\nline 2"));
+    QTest::keyClick(&logView, Qt::Key_Up, Qt::ShiftModifier);
+    QCOMPARE(logView.selectedText(), QString("line 0\nline 1\nline 2"));
+    QTest::keyClick(&logView, Qt::Key_Up, Qt::ShiftModifier);
+    QCOMPARE(logView.selectedText(), QString("line 0\nline 1\nline 2"));
+
+    // the selection stays on its lines while older ones are dropped
+    logView.setMaximumLineCount(9);
+    QCOMPARE(logView.selectedText(), QString("line 1\nline 2"));
+    QVERIFY(logView.isRowSelected(0));
+    QVERIFY(!logView.isRowSelected(2));
+    logView.setMaximumLineCount(5);
+    QVERIFY(!logView.hasSelection());
+
+    QTest::keyClick(&logView, Qt::Key_A, Qt::ControlModifier);
+    QCOMPARE(logView.selectedText(), QString("line 5\nline 6\nline 7\nline 8\nline 9"));
+    logView.repaint();
+    logView.clear();
+    QVERIFY(!logView.hasSelection());
+    QCOMPARE(logView.selectedText(), QString());
+}
+
+void LogViewTest::filterTest() {
+    LogView logView;
+    logView.resize(600, 200);
+    logView.setMaximumLineCount(10);
+    logView.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&logView));
+    logView.append("a\nb1\nc\nd1\ne\n");
+    QVERIFY(!logView.findNext());
+    logView.addMatches({1, 3});
+    QCOMPARE(logView.matchCount(), 2);
+    // from the top of the view, wrapping around at the ends
+    QVERIFY(logView.findNext());
+    QCOMPARE(logView.currentMatch(), qint64(1));
+    QVERIFY(logView.findNext());
+    QCOMPARE(logView.currentMatch(), qint64(3));
+    QVERIFY(logView.findNext());
+    QCOMPARE(logView.currentMatch(), qint64(1));
+    QVERIFY(logView.findPrevious());
+    QCOMPARE(logView.currentMatch(), qint64(3));
+
+    // rows are other lines once filtered, so the selection goes
+    logView.selectAll();
+    logView.setFiltered(true);
+    QVERIFY(!logView.hasSelection());
+    QCOMPARE(logView.rowCount(), 2);
+    logView.selectAll();
+    QCOMPARE(logView.selectedText(), QString("b1\nd1"));
+    logView.repaint();
+    // matches are dropped along with their lines
+    logView.append("f\ng\nh\ni\nj\nk\nl\n");
+    QCOMPARE(logView.lines().droppedLineCount(), qint64(2));
+    QCOMPARE(logView.matchCount(), 1);
+    QCOMPARE(logView.rowCount(), 1);
+    // and only lines after the last match are added
+    logView.addMatches({0, 3, 5});
+    QCOMPARE(logView.matchCount(), 2);
+
+    logView.setFiltered(false);
+    QCOMPARE(logView.rowCount(), 10);
+    logView.clearMatches();
+    QCOMPARE(logView.matchCount(), 0);
+    QCOMPARE(logView.currentMatch(), qint64(-1));
 }
 
 void PlotterViewTest::plotPointTest() {
@@ -24,13 +1155,175 @@ void PlotterViewTest::plotPointTest() {
     plotterView.ui->xRangeSpinBox->setValue(1);
     plotterView.plotPoint(15, 0, false);
     plotterView.plotPoint(-110, 1, true);
+    plotterView.refresh();
     plotterView.plotPoint(15, 0, false);
     plotterView.plotPoint(-110, 1, true);
+    plotterView.refresh();
     plotterView.plotPoint(-150, 1, true); // should handle seen skipped line (line 0)
+    plotterView.refresh();
     plotterView.plotPoint(-10, 100, true); // should handle unseen skipped line (line 1-99)
+    plotterView.refresh();
+    plotterView.clear();
+
+    plotterView.ui->xRangeSpinBox->setValue(10);
+    SampleFrame frame;
+    frame.values = {1, 2, 3, -4, 500};
+    frame.rowEnds = {3, 4, 5}; // rows of 3, 1 and 1 numbers
+    plotterView.plotFrame(frame);
+    QChart* chart = plotterView.findChild<QChartView*>()->chart();
+    QCOMPARE(chart->series().length(), 3);
+    auto line = static_cast<QLineSeries*>(chart->series()[1]);
+    // nothing is drawn until the next refresh
+    QCOMPARE(line->count(), 0);
+    QTRY_COMPARE(line->count(), 3);
+    // missing numbers are plotted at 0
+    QCOMPARE(line->pointsVector(), (QVector<QPointF>{{0, 2}, {1, 0}, {2, 0}}));
+    QVERIFY(static_cast<QValueAxis*>(chart->axisY())->max() >= 500);
+
+    // the series only hold what is kept in the history
+    plotterView.ui->historySpinBox->setValue(2);
+    QCOMPARE(line->pointsVector(), (QVector<QPointF>{{1, 0}, {2, 0}}));
+    // and only what is visible, plus the point just before
+    plotterView.ui->historySpinBox->setValue(100);
+    for (int i = 0; i < 20; ++i) {
+        plotterView.plotPoint(i, 1, true);
+    }
+    plotterView.ui->xRangeSpinBox->setValue(3);
+    QCOMPARE(line->count(), 4);
     plotterView.clear();
 }
 
+void PlotterViewTest::bestFitTest() {
+    PlotterView plotterView;
+    plotterView.ui->xRangeSpinBox->setValue(10);
+    plotterView.ui->bestFitRadio->setChecked(true);
+    // a peak in the middle of the window, not at either end
+    const QVector<qreal> values = {0, 1, 50, 1, -20, 1, 0};
+    for (qreal val : values) {
+        plotterView.plotPoint(val, 0, true);
+    }
+    plotterView.refresh();
+    QChart* chart = plotterView.findChild<QChartView*>()->chart();
+    auto axisY = static_cast<QValueAxis*>(chart->axisY());
+    QVERIFY(axisY->max() > 50);
+    QVERIFY(axisY->min() < -20);
+
+    // once the peak scrolls out of the window, best fit shrinks the range
+    plotterView.ui->xRangeSpinBox->setValue(2);
+    plotterView.ui->bestFitButton->click();
+    QVERIFY(axisY->max() < 50);
+    QVERIFY(axisY->min() > -20);
+
+    // widening the window brings the peak back
+    plotterView.ui->xRangeSpinBox->setValue(10);
+    plotterView.ui->bestFitButton->click();
+    QVERIFY(axisY->max() > 50);
+}
+
+void PlotterViewTest::extremesTest() {
+    PlotterView plotterView;
+    QVERIFY(plotterView.ui->maxMinRadio->isChecked());
+    const int xRange = plotterView.ui->xRangeSpinBox->value();
+
+    // a rising counter keeps every sample in the window as a candidate minimum,
+    // the ones that left the window must go even though Best fit isn't selected
+    SampleFrame frame;
+    for (int i = 1; i <= 1000; ++i) {
+        frame.values << i;
+        frame.rowEnds << i;
+    }
+    for (int block = 0; block < 100; ++block) {
+        plotterView.plotFrame(frame);
+        plotterView.refresh();
+        for (qreal& value : frame.values) {
+            value += 1000;
+        }
+    }
+    const WindowExtremes& extremes = plotterView.m_extremes[0];
+    QVERIFY(extremes.min() > 100000 - 2 * xRange);
+    QCOMPARE(extremes.max(), qreal(100000));
+}
+
+void PlotterViewTest::sourcesTest() {
+    PlotterView plotterView;
+    const int a = plotterView.addSource("A");
+    const int b = plotterView.addSource("B");
+    SampleFrame frame;
+    frame.source = a;
+    frame.values = {1, 2};
+    frame.rowEnds = {2};
+    plotterView.plotFrame(frame);
+    frame.source = b;
+    frame.values = {5};
+    frame.rowEnds = {1};
+    plotterView.plotFrame(frame);
+    frame.source = a;
+    frame.values = {3};
+    plotterView.plotFrame(frame);
+    plotterView.refresh();
+
+    // each source has its own channels, and rows of other sources don't pad them
+    const QList<QAbstractSeries*> series = plotterView.findChild<QChartView*>()->chart()->series();
+    QCOMPARE(series.length(), 3);
+    QCOMPARE(series[0]->name(), QString("A: 3"));
+    QCOMPARE(series[1]->name(), QString("A: 0"));
+    QCOMPARE(series[2]->name(), QString("B: 5"));
+    QCOMPARE(static_cast<QLineSeries*>(series[0])->pointsVector(), (QVector<QPointF>{{0, 1}, {2, 3}}));
+    QCOMPARE(static_cast<QLineSeries*>(series[2])->pointsVector(), QVector<QPointF>{QPointF(1, 5)});
+
+    plotterView.setSourceName(b, "C");
+    QCOMPARE(series[2]->name(), QString("C: 5"));
+}
+
+void PlotterViewTest::namedChannelsTest() {
+    PlotterView plotterView;
+    SampleFrame frame;
+    frame.values = {1, 20, 2, 40, 3};
+    frame.rowEnds = {2, 3, 4, 5};
+    frame.channels = {0, 1, 1, -1, 0};
+    frame.channelNames = QStringList{"temp", "volt"};
+    plotterView.plotFrame(frame);
+    plotterView.refresh();
+
+    // rows without a channel add no point to its line rather than a 0, whether it is named or not
+    const QList<QAbstractSeries*> series = plotterView.findChild<QChartView*>()->chart()->series();
+    QCOMPARE(series.length(), 3);
+    QCOMPARE(series[0]->name(), QString("temp"));
+    QCOMPARE(series[1]->name(), QString("volt"));
+    QCOMPARE(series[2]->name(), QString("40"));
+    QCOMPARE(static_cast<QLineSeries*>(series[0])->pointsVector(), (QVector<QPointF>{{0, 1}, {3, 3}}));
+    QCOMPARE(static_cast<QLineSeries*>(series[1])->pointsVector(), (QVector<QPointF>{{0, 20}, {1, 2}}));
+    QCOMPARE(static_cast<QLineSeries*>(series[2])->pointsVector(), QVector<QPointF>{QPointF(2, 40)});
+}
+
+void PlotterViewTest::timeAxisTest() {
+    PlotterView plotterView;
+    plotterView.ui->timeAxisCheckBox->setChecked(true);
+    QVERIFY(plotterView.ui->xRangeSpinBox->isHidden());
+    QVERIFY(!plotterView.ui->timeRangeSpinBox->isHidden());
+    plotterView.ui->timeRangeSpinBox->setValue(2);
+
+    SampleFrame frame;
+    frame.values = {1, 2, 3, 4};
+    frame.rowEnds = {1, 2, 3, 4};
+    frame.rowTimes = {1000000000, 1500000000, 2500000000, 4000000000};
+    plotterView.plotFrame(frame);
+    plotterView.refresh();
+
+    // the window covers the last 2 s, starting one row early so the line enters from the left edge
+    QChart* chart = plotterView.findChild<QChartView*>()->chart();
+    auto axisX = static_cast<QValueAxis*>(chart->axisX());
+    QCOMPARE(axisX->min(), qreal(2));
+    QCOMPARE(axisX->max(), qreal(4));
+    auto line = static_cast<QLineSeries*>(chart->series()[0]);
+    QCOMPARE(line->pointsVector(), (QVector<QPointF>{{1.5, 2}, {2.5, 3}, {4, 4}}));
+
+    // back to rows, one after the other
+    plotterView.ui->timeAxisCheckBox->setChecked(false);
+    QCOMPARE(axisX->min(), qreal(0));
+    QCOMPARE(line->pointsVector(), (QVector<QPointF>{{0, 1}, {1, 2}, {2, 3}, {3, 4}}));
+}
+
 MainWindowTest::MainWindowTest()
     : mainWindow("", "", false)
 {}
@@ -47,34 +1340,356 @@ void MainWindowTest::uiTests() {
     QCOMPARE(mainWindow.ui->plotterButton->isChecked(), true);
     mainWindow.ui->plotterButton->toggle();
     mainWindow.ui->portReload->click();
+    // the monitor is hidden while it is off
+    mainWindow.ui->monitorMode->setCurrentIndex(Worker::MonitorOff);
+    QVERIFY(mainWindow.m_logView->isHidden());
+    mainWindow.ui->monitorMode->setCurrentIndex(Worker::MonitorPaused);
+    QVERIFY(!mainWindow.m_logView->isHidden());
+    QVERIFY(!mainWindow.ui->autoScroll->isEnabled());
+    mainWindow.ui->monitorMode->setCurrentIndex(Worker::MonitorLive);
+    QVERIFY(mainWindow.ui->autoScroll->isEnabled());
 }
 
 void MainWindowTest::monitorViewTests() {
-    QScrollBar* scroller = mainWindow.ui->plainTextEdit->verticalScrollBar();
+    QScrollBar* scroller = mainWindow.m_logView->verticalScrollBar();
     scroller->setSliderDown(true);
     // scroller pressed down - don't scroll to bottom
-    mainWindow.output("Hello world 1");
+    mainWindow.m_queue.pushText("Hello world 1");
+    mainWindow.drainQueue();
+    mainWindow.flushOutput();
     scroller->setSliderDown(false);
     // scroller released - scroll to bottom
-    mainWindow.output("Hello world 2");
+    mainWindow.m_queue.pushText("Hello world 2");
+    mainWindow.drainQueue();
+    mainWindow.flushOutput();
     // auto scroll disabled - don't scroll to bottom
     mainWindow.ui->autoScroll->setChecked(false);
-    mainWindow.output("Hello world 3");
+    mainWindow.m_queue.pushText("Hello world 3");
+    mainWindow.drainQueue();
+    mainWindow.flushOutput();
+    mainWindow.ui->autoScroll->setChecked(true);
+}
+
+void MainWindowTest::scrollbackTest() {
+    LogView* logView = mainWindow.m_logView;
+    logView->clear();
+    mainWindow.ui->scrollbackSpinBox->setValue(5);
+    // output arriving within a frame ends up in a single append
+    for (int i = 0; i < 100; ++i) {
+        mainWindow.m_queue.pushText(QString("line %1\n").arg(i));
+    }
+    QCOMPARE(logView->toPlainText(), QString());
+    QTRY_VERIFY(!logView->toPlainText().isEmpty());
+    // only the newest lines are kept
+    QCOMPARE(logView->lines().lineCount(), 5);
+    QVERIFY(logView->toPlainText().contains("line 99"));
+    QVERIFY(!logView->toPlainText().contains("line 0\n"));
+
+    // output still waiting for the next frame goes along with the rest
+    mainWindow.m_queue.pushText("stale\n");
+    mainWindow.m_queue.pushBytes("stale\n");
+    mainWindow.drainQueue();
+    mainWindow.ui->clearButton->click();
+    mainWindow.flushOutput();
+    QCOMPARE(logView->toPlainText(), QString());
+    QCOMPARE(mainWindow.m_hexView->rowCount(), 0);
+}
+
+void MainWindowTest::recordingTest() {
+    QTemporaryDir dir;
+    const QString path = dir.filePath("test.wcap");
+    QVERIFY(mainWindow.startRecording(path));
+    QVERIFY(mainWindow.ui->recordButton->isChecked());
+    mainWindow.stopRecording();
+    QVERIFY(!mainWindow.ui->recordButton->isChecked());
+    // an empty capture is just the header and the trailer
+    QCOMPARE(QFileInfo(path).size(), qint64(CAPTURE_HEADERSIZE + CAPTURE_TRAILERSIZE));
+}
+
+void MainWindowTest::replayTest() {
+    QTemporaryDir dir;
+    const QString path = dir.filePath("test.wcap");
+    QVERIFY(writeFile(path, captureHeader() + captureChunk(0, "replayed ") + captureChunk(1000, "output\n")));
+    mainWindow.ui->replaySpeed->setCurrentText("Max");
+    mainWindow.startReplay(path);
+    QVERIFY(mainWindow.ui->replayButton->isChecked());
+    QTRY_VERIFY(!mainWindow.ui->replayButton->isChecked());
+    QTRY_VERIFY(mainWindow.m_logView->toPlainText().contains("replayed output"));
+    QVERIFY(mainWindow.ui->statusBar->currentMessage().startsWith("Replayed 16 bytes"));
+}
+
+void MainWindowTest::replayBlockTest() {
+    QTemporaryDir dir;
+    const QString path = dir.filePath("test.wcap");
+    QByteArray capture = captureHeader();
+    QString expected;
+    for (int i = 0; i < 200; ++i) {
+        const QByteArray line = QByteArray::number(1000 + i) + "\n";
+        capture += captureChunk(i, line);
+        expected += line;
+    }
+    QVERIFY(writeFile(path, capture));
+
+    // the queue holds far less than the capture, so the replay has to wait for the window
+    MainWindow window("", "", false);
+    window.ui->overloadPolicy->setCurrentIndex(OutputQueue::BlockReader);
+    window.m_queue.setCapacity(1000, 16);
+    QSignalSpy drainedSpy(&window.m_queue, &OutputQueue::drained);
+    window.ui->replaySpeed->setCurrentText("Max");
+    window.startReplay(path);
+    QTRY_VERIFY(!window.ui->replayButton->isChecked());
+    QVERIFY(drainedSpy.count() > 0);
+    QTRY_COMPARE(window.m_logView->toPlainText(), expected);
+    QCOMPARE(window.m_queue.droppedCharacters(), qint64(0));
+    window.close();
+}
+
+void MainWindowTest::searchTest() {
+    LogView* logView = mainWindow.m_logView;
+    mainWindow.clearOutput();
+    mainWindow.ui->scrollbackSpinBox->setValue(100);
+    mainWindow.ui->searchEdit->setText("error");
+    for (int i = 0; i < 20; ++i) {
+        mainWindow.m_queue.pushText(i % 5 == 0 ? "error\r\n" : "ok\r\n");
+    }
+    mainWindow.drainQueue();
+    mainWindow.flushOutput();
+    // the lines are searched in the searcher's thread
+    QTRY_COMPARE(logView->matchCount(), 4);
+    QCOMPARE(mainWindow.ui->searchStatus->text(), QString("4 matches"));
+
+    mainWindow.ui->filterCheckBox->setChecked(true);
+    QVERIFY(logView->isFiltered());
+    QCOMPARE(logView->rowCount(), 4);
+    // moving to a match stops new output from scrolling it away
+    mainWindow.ui->searchNextButton->click();
+    QVERIFY(logView->currentMatch() >= 0);
+    QVERIFY(!mainWindow.ui->autoScroll->isChecked());
+    mainWindow.ui->autoScroll->setChecked(true);
+
+    mainWindow.ui->regexCheckBox->setChecked(true);
+    mainWindow.ui->searchEdit->setText("(");
+    QVERIFY(mainWindow.ui->searchStatus->text().startsWith("Invalid pattern"));
+    // nothing is filtered without a search
+    mainWindow.ui->searchEdit->clear();
+    QVERIFY(!logView->isFiltered());
+    QVERIFY(mainWindow.ui->searchStatus->text().isEmpty());
+    mainWindow.ui->regexCheckBox->setChecked(false);
+    mainWindow.ui->filterCheckBox->setChecked(false);
 }
 
 void MainWindowTest::cleanupTestCase() {
     mainWindow.close();
 }
 
+void LoopbackTest::initTestCase() {
+    PtyLoopback pty;
+    if (!pty.open()) {
+        QSKIP("Pseudo-terminals are not available");
+    }
+}
+
+void LoopbackTest::mainWindowTest() {
+    PtyLoopback pty;
+    QVERIFY(pty.open());
+    // the pty can't be enumerated, but is selectable by its path
+    MainWindow window(pty.portName(), "115200", true);
+    window.show();
+    QVERIFY(window.ui->port->currentText().endsWith(QSerialPortInfo(pty.portName()).portName()));
+    QVERIFY(window.ui->monitorButton->isChecked());
+    window.ui->plotterButton->toggle();
+
+    // wait for the reader to drop its first read, after which nothing is lost
+    pty.pump("\n", 1, 0);
+    QTRY_VERIFY(pty.isIdle());
+    QTest::qWait(200);
+    pty.pump(PtyLoopback::lines(1000, 100, 3), 17, 1);
+    QTRY_VERIFY(window.m_logView->toPlainText().contains("1099,2198,3297\n"));
+
+    window.ui->lineEdit->setText("hello");
+    window.ui->sendButton->click();
+    QByteArray received;
+    QTRY_VERIFY((received += pty.readAll()).contains("hello"));
+    QTRY_VERIFY(window.ui->lineEdit->text().isEmpty());
+    window.close();
+}
+
+void LoopbackTest::throughputTest_data() {
+    QTest::addColumn<int>("burstSize");
+    QTest::addColumn<int>("interval");
+    QTest::addColumn<qreal>("corruption");
+
+    QTest::newRow("as fast as possible") << 4096 << 0 << 0.0;
+    QTest::newRow("small bursts") << 100 << 0 << 0.0;
+    QTest::newRow("paced bursts") << 2000 << 1 << 0.0;
+    QTest::newRow("corrupted") << 4096 << 0 << 0.001;
+}
+
+void LoopbackTest::throughputTest() {
+    QFETCH(int, burstSize);
+    QFETCH(int, interval);
+    QFETCH(qreal, corruption);
+
+    PtyLoopback pty;
+    QVERIFY(pty.open());
+    // the whole read, parse and frame chain, each on its own thread like in MainWindow
+    QThread readerThread;
+    QThread workerThread;
+    PortReader* reader = new PortReader;
+    Worker* worker = new Worker;
+    worker->plotEnabled = true;
+    reader->moveToThread(&readerThread);
+    worker->moveToThread(&workerThread);
+    connect(&readerThread, &QThread::finished, reader, &QObject::deleteLater);
+    connect(&workerThread, &QThread::finished, worker, &QObject::deleteLater);
+    connect(reader, &PortReader::dataRead, worker, &Worker::processData);
+    qint64 bytes = 0;
+    int rows = 0;
+    int samples = 0;
+    qreal lastFirstValue = -1;
+    bool ordered = true;
+    // counts in this thread, and drops counts still queued when it goes away
+    QObject counter;
+    connect(reader, &PortReader::dataRead, &counter, [&bytes](const QByteArray& buf) { bytes += buf.size(); });
+    connect(worker, &Worker::plotFrame, &counter, [&](const SampleFrame& frame) {
+        int rowStart = 0;
+        for (const int rowEnd : frame.rowEnds) {
+            ordered = ordered && frame.values[rowStart] > lastFirstValue;
+            lastFirstValue = frame.values[rowStart];
+            rowStart = rowEnd;
+        }
+        rows += frame.rowCount();
+        samples += frame.values.size();
+    });
+    readerThread.start();
+    workerThread.start();
+    QMetaObject::invokeMethod(reader, "setPortName", Q_ARG(QString, pty.portName()));
+    QMetaObject::invokeMethod(reader, "open");
+
+    // wait for the reader to drop its first read, after which nothing is lost
+    pty.pump("\n", 1, 0);
+    QTRY_VERIFY(pty.isIdle());
+    QTest::qWait(200);
+    bytes = 0;
+
+    const int count = 20000;
+    QByteArray data = PtyLoopback::lines(0, count, 4);
+    PtyLoopback::corrupt(data, corruption, 42);
+    QElapsedTimer timer;
+    timer.start();
+    pty.pump(data, burstSize, interval);
+    QTRY_COMPARE_WITH_TIMEOUT(bytes, qint64(data.size()), 30000);
+    if (corruption == 0) {
+        QTRY_COMPARE(rows, count);
+        QCOMPARE(samples, count * 4);
+        QVERIFY(ordered);
+    } else {
+        // a corrupted byte costs at most the rows on either side of it
+        QTRY_VERIFY(rows > count * 9 / 10);
+        QVERIFY(rows <= count);
+    }
+    const qreal seconds = timer.nsecsElapsed() / 1e9;
+    qInfo("%.2f MB/s, %.0f rows/s", data.size() / seconds / 1e6, rows / seconds);
+
+    QMetaObject::invokeMethod(reader, "close");
+    readerThread.quit();
+    readerThread.wait();
+    workerThread.quit();
+    workerThread.wait();
+}
+
+void LoopbackTest::sharedPlotTest() {
+    PtyLoopback ptys[2];
+    PlotterView sharedPlotterView;
+    MainWindow* windows[2];
+    for (int i = 0; i < 2; ++i) {
+        QVERIFY(ptys[i].open());
+        windows[i] = new MainWindow(ptys[i].portName(), "115200", true);
+        windows[i]->setSharedPlotterView(&sharedPlotterView);
+        windows[i]->show();
+        windows[i]->ui->plotterButton->toggle();
+        ptys[i].pump("\n", 1, 0);
+    }
+    QTRY_VERIFY(ptys[0].isIdle() && ptys[1].isIdle());
+    QTest::qWait(200);
+
+    // both windows plot into the one plotter, each with its own channels
+    ptys[0].pump(PtyLoopback::lines(1, 50, 2), 64, 1);
+    ptys[1].pump(PtyLoopback::lines(1, 50, 3), 64, 1);
+    QChart* chart = sharedPlotterView.findChild<QChartView*>()->chart();
+    QTRY_COMPARE(chart->series().length(), 5);
+    const auto names = [chart]() {
+        QStringList names;
+        for (QAbstractSeries* series : chart->series()) {
+            names << series->name();
+        }
+        return names;
+    };
+    for (int i = 0; i < 2; ++i) {
+        const QString portName = QSerialPortInfo(ptys[i].portName()).portName();
+        QTRY_COMPARE(names().filter(portName + ": ").length(), 2 + i);
+        QTRY_VERIFY(names().contains(QString("%1: %2").arg(portName).arg(50 * (2 + i))));
+    }
+    QVERIFY(sharedPlotterView.isVisible());
+
+    // closing one window leaves the plotter to the other
+    windows[0]->ui->plotterButton->toggle();
+    QVERIFY(sharedPlotterView.isVisible());
+    for (MainWindow* window : windows) {
+        window->close();
+        delete window;
+    }
+}
+
 int main(int argc, char *argv[]) {
     QApplication app(argc, argv);
     app.setAttribute(Qt::AA_Use96Dpi, true);
     WorkerTest workerTest;
+    LineParserTest lineParserTest;
+    ChannelTableTest channelTableTest;
+    DelimiterScannerTest delimiterScannerTest;
+    FrameDecoderTest frameDecoderTest;
+    PortReaderTest portReaderTest;
+    CaptureWriterTest captureWriterTest;
+    CapturePlayerTest capturePlayerTest;
+    HeadlessStreamerTest headlessStreamerTest;
+    OutputQueueTest outputQueueTest;
+    PipelineStatsTest pipelineStatsTest;
+    SampleBufferTest sampleBufferTest;
+    ByteRingTest byteRingTest;
+    LineStoreTest lineStoreTest;
+    LineSearcherTest lineSearcherTest;
+    TimeBufferTest timeBufferTest;
+    DecimatorTest decimatorTest;
+    WindowExtremesTest windowExtremesTest;
+    HexViewTest hexViewTest;
+    LogViewTest logViewTest;
     PlotterViewTest plotterViewTest;
     MainWindowTest mainWindowTest;
+    LoopbackTest loopbackTest;
     QTEST_SET_MAIN_SOURCE_PATH
 
     return QTest::qExec(&workerTest, argc, argv)
+         + QTest::qExec(&lineParserTest, argc, argv)
+         + QTest::qExec(&channelTableTest, argc, argv)
+         + QTest::qExec(&delimiterScannerTest, argc, argv)
+         + QTest::qExec(&frameDecoderTest, argc, argv)
+         + QTest::qExec(&portReaderTest, argc, argv)
+         + QTest::qExec(&captureWriterTest, argc, argv)
+         + QTest::qExec(&capturePlayerTest, argc, argv)
+         + QTest::qExec(&headlessStreamerTest, argc, argv)
+         + QTest::qExec(&outputQueueTest, argc, argv)
+         + QTest::qExec(&pipelineStatsTest, argc, argv)
+         + QTest::qExec(&sampleBufferTest, argc, argv)
+         + QTest::qExec(&byteRingTest, argc, argv)
+         + QTest::qExec(&lineStoreTest, argc, argv)
+         + QTest::qExec(&lineSearcherTest, argc, argv)
+         + QTest::qExec(&timeBufferTest, argc, argv)
+         + QTest::qExec(&decimatorTest, argc, argv)
+         + QTest::qExec(&windowExtremesTest, argc, argv)
+         + QTest::qExec(&hexViewTest, argc, argv)
+         + QTest::qExec(&logViewTest, argc, argv)
          + QTest::qExec(&plotterViewTest, argc, argv)
-         + QTest::qExec(&mainWindowTest, argc, argv);
+         + QTest::qExec(&mainWindowTest, argc, argv)
+         + QTest::qExec(&loopbackTest, argc, argv);
 }
@@ -3,10 +3,29 @@
 #include <QtTest/QtTest>
 #include <QtTest/QSignalSpy>
 #include "worker.h"
+#include "lineparser.h"
+#include "channeltable.h"
+#include "delimiterscanner.h"
+#include "framedecoder.h"
+#include "portreader.h"
+#include "capturewriter.h"
+#include "captureplayer.h"
+#include "headlessstreamer.h"
+#include "outputqueue.h"
+#include "samplebuffer.h"
+#include "bytering.h"
+#include "linestore.h"
+#include "linesearcher.h"
+#include "timebuffer.h"
+#include "decimator.h"
+#include "windowextremes.h"
+#include "hexview.h"
+#include "logview.h"
 #include "plotterview.h"
 #include "ui_plotterview.h"
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
+#include "ptyloopback.h"
 
 namespace Ui {
 class PlotterViewTest;
@@ -16,12 +35,151 @@ class WorkerTest: public QObject {
     Q_OBJECT
 private slots:
     void processDataTest();
+    void timestampTest();
+    void statsTest();
+    void monitorModeTest();
+};
+
+class LineParserTest: public QObject {
+    Q_OBJECT
+private slots:
+    void feedTest_data();
+    void feedTest();
+    void splitLineTest();
+    void namedTest_data();
+    void namedTest();
+};
+
+class ChannelTableTest: public QObject {
+    Q_OBJECT
+private slots:
+    void internTest();
+};
+
+class DelimiterScannerTest: public QObject {
+    Q_OBJECT
+private slots:
+    void kernelsTest();
+};
+
+class FrameDecoderTest: public QObject {
+    Q_OBJECT
+private slots:
+    void cobsTest();
+    void slipTest();
+};
+
+class PortReaderTest: public QObject {
+    Q_OBJECT
+private slots:
+    void openErrorTest();
+};
+
+class CaptureWriterTest: public QObject {
+    Q_OBJECT
+private slots:
+    void fileFormatTest();
+    void stalledDiskTest();
+};
+
+class CapturePlayerTest: public QObject {
+    Q_OBJECT
+private slots:
+    void replayTest();
+    void timingTest();
+};
+
+class HeadlessStreamerTest: public QObject {
+    Q_OBJECT
+private slots:
+    void csvTest();
+    void rawTest();
+    void openErrorTest();
+};
+
+class OutputQueueTest: public QObject {
+    Q_OBJECT
+private slots:
+    void dropOldestTest();
+    void decimateTest();
+    void blockReaderTest();
+};
+
+class PipelineStatsTest: public QObject {
+    Q_OBJECT
+private slots:
+    void summaryTest();
+};
+
+class SampleBufferTest: public QObject {
+    Q_OBJECT
+private slots:
+    void ringTest();
+};
+
+class ByteRingTest: public QObject {
+    Q_OBJECT
+private slots:
+    void ringTest();
+};
+
+class LineStoreTest: public QObject {
+    Q_OBJECT
+private slots:
+    void linesTest();
+    void trimTest();
+};
+
+class LineSearcherTest: public QObject {
+    Q_OBJECT
+private slots:
+    void searchTest();
+    void chunksTest();
+};
+
+class TimeBufferTest: public QObject {
+    Q_OBJECT
+private slots:
+    void blocksTest();
+};
+
+class DecimatorTest: public QObject {
+    Q_OBJECT
+private slots:
+    void pointsTest();
+};
+
+class WindowExtremesTest: public QObject {
+    Q_OBJECT
+private slots:
+    void slidingWindowTest();
+};
+
+class HexViewTest: public QObject {
+    Q_OBJECT
+private slots:
+    void formatRowTest();
+    void scrollTest();
+};
+
+class LogViewTest: public QObject {
+    Q_OBJECT
+private slots:
+    void formatLineTest();
+    void appendTest();
+    void selectionTest();
+    void filterTest();
 };
 
 class PlotterViewTest: public QObject {
     Q_OBJECT
 private slots:
     void plotPointTest();
+    void bestFitTest();
+    void extremesTest();
+    void sourcesTest();
+    void namedChannelsTest();
+    void timeAxisTest();
 };
 
 class MainWindowTest: public QObject {
@@ -35,7 +193,22 @@ private slots:
     void initTestCase();
     void uiTests();
     void monitorViewTests();
+    void scrollbackTest();
+    void recordingTest();
+    void replayTest();
+    void replayBlockTest();
+    void searchTest();
     void cleanupTestCase();
 };
 
+class LoopbackTest: public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void mainWindowTest();
+    void throughputTest_data();
+    void throughputTest();
+    void sharedPlotTest();
+};
+
 #endif // TEST_H
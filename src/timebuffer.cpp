@@ -0,0 +1,87 @@
+/**
+ * @file timebuffer.cpp
+ * @brief Implementation of TimeBuffer class
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#include "timebuffer.h"
+
+// rows per block, so old rows are dropped in small steps
+#define BLOCKSIZE 4096
+// the largest offset from the base of a block, in µs
+#define MAXOFFSET 0xFFFFFFFFLL
+
+TimeBuffer::TimeBuffer() :
+    m_offsetsX(0),
+    m_endX(0),
+    m_last(0) {}
+
+void TimeBuffer::append(const qint64 time) {
+    const qint64 t = isEmpty() ? time : qMax(time, m_last);
+    m_last = t;
+    if (m_blocks.isEmpty() || m_endX - m_blocks.last().x >= BLOCKSIZE
+            || (t - m_blocks.last().base) / 1000 > MAXOFFSET) {
+        m_blocks.append({m_endX, t});
+    }
+    m_offsets.append(quint32((t - m_blocks.last().base) / 1000));
+    ++m_endX;
+}
+
+qint64 TimeBuffer::at(const int x) const {
+    return m_blocks[blockOf(x)].base + qint64(m_offsets[x - m_offsetsX]) * 1000;
+}
+
+int TimeBuffer::lowerBound(const qint64 time) const {
+    int low = firstX();
+    int high = m_endX;
+    while (low < high) {
+        const int mid = low + (high - low) / 2;
+        if (at(mid) < time) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+void TimeBuffer::discardBefore(const int x) {
+    int dropped = 0;
+    while (dropped < m_blocks.size() - 1 && m_blocks[dropped + 1].x <= x) {
+        ++dropped;
+    }
+    if (dropped == 0) return;
+    m_blocks.remove(0, dropped);
+    // removing from the front is linear, so only done once half the offsets are unused
+    const int unused = m_blocks.first().x - m_offsetsX;
+    if (unused * 2 >= m_offsets.size()) {
+        m_offsets.remove(0, unused);
+        m_offsetsX += unused;
+    }
+}
+
+void TimeBuffer::clear() {
+    m_blocks.clear();
+    m_offsets.clear();
+    m_offsetsX = 0;
+    m_endX = 0;
+    m_last = 0;
+}
+
+int TimeBuffer::blockOf(const int x) const {
+    // the last block whose first row is at or before x
+    int low = 0;
+    int high = m_blocks.size() - 1;
+    while (low < high) {
+        const int mid = low + (high - low + 1) / 2;
+        if (m_blocks[mid].x <= x) {
+            low = mid;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return low;
+}
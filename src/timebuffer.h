@@ -0,0 +1,116 @@
+/**
+ * @file timebuffer.h
+ * @brief Compact timestamps of the rows plotted by the plotter, indexed by their x-value
+ *
+ * Rows are stored in blocks: a full 64-bit base time per block, and a 32-bit offset
+ * from that base per row, in µs. A new block starts when a block is full or an offset
+ * no longer fits, so a row takes little more than 4 bytes.
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#ifndef TIMEBUFFER_H
+#define TIMEBUFFER_H
+
+#include <QVector>
+
+class TimeBuffer {
+public:
+    /**
+     * Constructs an empty buffer whose first row has the x-value 0
+     */
+    TimeBuffer();
+
+    /**
+     * @return the x-value of the oldest row still held
+     */
+    int firstX() const { return m_blocks.isEmpty() ? m_endX : m_blocks.first().x; }
+
+    /**
+     * @return the x-value of the next row to be appended
+     */
+    int endX() const { return m_endX; }
+
+    /**
+     * @return whether no rows are held
+     */
+    bool isEmpty() const { return firstX() == m_endX; }
+
+    /**
+     * Appends the time of the next row
+     *
+     * Times are kept in ascending order, a time before the last one is stored as the last one
+     *
+     * @param time the time of the row, in ns
+     */
+    void append(const qint64 time);
+
+    /**
+     * @param x the x-value of the row, in [firstX(), endX())
+     * @return the time of the row, in ns with µs resolution
+     */
+    qint64 at(const int x) const;
+
+    /**
+     * Binary searches for the first row with a time of at least the given time
+     *
+     * @param time the time to search for, in ns
+     * @return the x-value of the row, or endX() if there is none
+     */
+    int lowerBound(const qint64 time) const;
+
+    /**
+     * Drops the blocks that only hold rows before the given x-value
+     *
+     * @param x the smallest x-value that is still needed
+     */
+    void discardBefore(const int x);
+
+    /**
+     * Removes all rows, the next row appended gets the x-value 0
+     */
+    void clear();
+
+private:
+    /**
+     * A run of rows sharing one base time
+     */
+    struct Block {
+        int x;
+        qint64 base;
+    };
+
+    /**
+     * The blocks, oldest first
+     */
+    QVector<Block> m_blocks;
+
+    /**
+     * Time of every row since the base of its block in µs, starting at `m_offsetsX`
+     */
+    QVector<quint32> m_offsets;
+
+    /**
+     * x-value of the first offset, the offsets of dropped blocks are removed in batches
+     */
+    int m_offsetsX;
+
+    /**
+     * x-value of the next row
+     */
+    int m_endX;
+
+    /**
+     * Time of the last row, in ns
+     */
+    qint64 m_last;
+
+    /**
+     * @return the index in `m_blocks` of the block holding the given row
+     */
+    int blockOf(const int x) const;
+};
+
+#endif // TIMEBUFFER_H
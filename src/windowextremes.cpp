@@ -0,0 +1,37 @@
+/**
+ * @file windowextremes.cpp
+ * @brief Implementation of WindowExtremes class
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#include "windowextremes.h"
+
+WindowExtremes::WindowExtremes() :
+    m_minFirst(0),
+    m_maxFirst(0) {}
+
+void WindowExtremes::discardBefore(const int x) {
+    popFront(m_min, m_minFirst, x);
+    popFront(m_max, m_maxFirst, x);
+}
+
+void WindowExtremes::clear() {
+    m_min.clear();
+    m_max.clear();
+    m_minFirst = 0;
+    m_maxFirst = 0;
+}
+
+void WindowExtremes::popFront(QVector<Entry>& deque, int& first, const int x) {
+    while (first < deque.size() && deque[first].x < x) {
+        ++first;
+    }
+    // only move the remaining entries once half of the storage is unused
+    if (first > 64 && first * 2 > deque.size()) {
+        deque.remove(0, first);
+        first = 0;
+    }
+}
@@ -0,0 +1,104 @@
+/**
+ * @file windowextremes.h
+ * @brief Minimum and maximum of one line of the plotter over a sliding window
+ *
+ * @author Ambareesh Balaji
+ * @date October 16, 2026
+ * @bug No known bugs
+ */
+
+#ifndef WINDOWEXTREMES_H
+#define WINDOWEXTREMES_H
+
+#include <QVector>
+
+class WindowExtremes {
+public:
+    /**
+     * Constructs an empty window
+     */
+    WindowExtremes();
+
+    /**
+     * Adds a sample to the right end of the window
+     *
+     * x-values must be appended in ascending order
+     *
+     * @param x the x-value of the sample
+     * @param y the y-value of the sample
+     */
+    inline void append(const int x, const qreal y);
+
+    /**
+     * Moves the left end of the window, dropping samples before the given x-value
+     *
+     * @param x the new left end
+     */
+    void discardBefore(const int x);
+
+    /**
+     * @return whether there are no samples in the window
+     */
+    bool isEmpty() const { return m_min.size() == m_minFirst; }
+
+    /**
+     * @return the smallest y-value in the window, which must not be empty
+     */
+    qreal min() const { return m_min[m_minFirst].y; }
+
+    /**
+     * @return the largest y-value in the window, which must not be empty
+     */
+    qreal max() const { return m_max[m_maxFirst].y; }
+
+    /**
+     * Removes all samples
+     */
+    void clear();
+
+private:
+    struct Entry {
+        int x;
+        qreal y;
+    };
+
+    /**
+     * Deque of samples with ascending y-values, the front being the minimum
+     *
+     * A sample is dropped once a newer one is at most as large, since it can never be the minimum again
+     */
+    QVector<Entry> m_min;
+
+    /**
+     * Deque of samples with descending y-values, the front being the maximum
+     */
+    QVector<Entry> m_max;
+
+    /**
+     * Position of the front of `m_min`, the entries before it are removed in batches
+     */
+    int m_minFirst;
+
+    /**
+     * Position of the front of `m_max`
+     */
+    int m_maxFirst;
+
+    /**
+     * Drops the entries of the deque before the given x-value
+     */
+    static void popFront(QVector<Entry>& deque, int& first, const int x);
+};
+
+inline void WindowExtremes::append(const int x, const qreal y) {
+    while (m_min.size() > m_minFirst && m_min.last().y >= y) {
+        m_min.removeLast();
+    }
+    m_min.append({x, y});
+    while (m_max.size() > m_maxFirst && m_max.last().y <= y) {
+        m_max.removeLast();
+    }
+    m_max.append({x, y});
+}
+
+#endif // WINDOWEXTREMES_H
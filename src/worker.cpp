@@ -8,51 +8,141 @@
  */
 
 #include "worker.h"
-#include <QRegularExpression>
-#include <QRegularExpressionMatch>
-#include <QRegularExpressionMatchIterator>
+#include "monotonicclock.h"
+#include <QTextCodec>
 
-Worker::Worker() : plotEnabled(false) {}
+// start, 8 data and stop bit
+#define BITSPERBYTE 10
+// IANA number of the UTF-8 character set
+#define UTF8MIB 106
+// a UTF-8 sequence has at most this many continuation bytes
+#define MAXCONTINUATIONBYTES 3
 
-void Worker::processData(const QByteArray& buf) {
-    const QString cur = QString::fromUtf8(buf);
-    emit output(cur);
+Worker::Worker() :
+    plotEnabled(false),
+    m_inputMode(TextInput),
+    m_monitorMode(MonitorLive),
+    m_monitorFormat(TextFormat),
+    m_textDecoder(QTextCodec::codecForMib(UTF8MIB)->makeDecoder(QTextCodec::IgnoreHeader)),
+    m_resyncBytes(0),
+    m_stats(nullptr),
+    m_lastReadTime(-1),
+    m_byteTime(0) {
+    qRegisterMetaType<SampleFrame>();
+}
+
+void Worker::processData(const QByteArray& buf, const qint64 time) {
+    const qint64 readTime = time >= 0 ? time : MonotonicClock::now();
+    if (m_stats != nullptr) {
+        m_stats->addBytesProcessed(buf.size());
+    }
+    if (m_monitorMode == MonitorLive) {
+        if (m_monitorFormat == HexFormat) {
+            if (m_stats != nullptr) {
+                m_stats->addTextQueued(buf.size());
+            }
+            emit outputBytes(buf);
+        } else {
+            outputText(buf);
+        }
+    }
     if (plotEnabled) {
-        // this regular expression checks for a comma/tab/space separated list
-        // of decimal numbers followed by either CRLF or LF
-        QRegularExpression re("(-?\\d+(\\.\\d+)?([, \\t]+-?\\d+(\\.\\d+)?)*)\\r?\\n");
-        // if the output was broken up into separate packets
-        // we need to keep track of the previous leftover value
-        QString& combined = m_leftover += cur;
-        QRegularExpressionMatchIterator matches = re.globalMatch(combined);
-        int lastMatchIndex = -1;
-        while (matches.hasNext()) {
-            QRegularExpressionMatch match = matches.next();
-            QString line = match.captured(1);
-            QStringList words = line.split(QRegularExpression("[, \\t]+"));
-
-            int i = 0;
-            for (; i < words.length() - 1; ++i) {
-                QString word = words[i];
-                bool ok;
-                double number = word.toDouble(&ok);
-                if (ok) {
-                    emit plotPoint(qreal(number), i, false);
-                }
+        // the parser and decoder keep track of lines and frames broken up into separate packets
+        SampleFrame frame;
+        m_rowOffsets.resize(0);
+        qint64 rejected;
+        if (m_inputMode == TextInput) {
+            rejected = m_parser.rejectedCount();
+            m_parser.feed(buf, frame.values, frame.rowEnds, &m_rowOffsets, &frame.channels);
+            if (!frame.channels.isEmpty()) {
+                // shared with the parser until it finds a new name
+                frame.channelNames = m_parser.channelNames();
             }
-            QString word = words[i];
-            bool ok;
-            double number = word.toDouble(&ok);
-            if (ok) {
-                // true to increment the plot after last number in the line
-                emit plotPoint(qreal(number), i, true);
+            rejected = m_parser.rejectedCount() - rejected;
+        } else {
+            rejected = m_decoder.errorCount();
+            m_decoder.feed(buf, frame.values, frame.rowEnds, &m_rowOffsets);
+            rejected = m_decoder.errorCount() - rejected;
+        }
+        if (m_stats != nullptr) {
+            m_stats->addRows(frame.rowCount(), rejected);
+        }
+        if (frame.rowCount() > 0) {
+            stampRows(frame, buf.size(), readTime);
+            if (m_stats != nullptr) {
+                m_stats->addFrameQueued();
             }
-            // this returns the first index after the last match
-            // or -1 if nothing was matched
-            lastMatchIndex = match.capturedEnd(0);
+            // one queued event for the whole buffer instead of one per number
+            emit plotFrame(frame);
         }
-        if (lastMatchIndex == -1) ++lastMatchIndex;
-        // mid returns the substring starting at lastMatchIndex to the end
-        m_leftover = combined.mid(lastMatchIndex);
     }
+    m_lastReadTime = readTime;
+}
+
+inline void Worker::outputText(const QByteArray& buf) {
+    const char* begin = buf.constData();
+    const char* const end = begin + buf.size();
+    // skip what is left of a sequence whose start was never decoded
+    while (m_resyncBytes > 0 && begin < end) {
+        if ((quint8(*begin) & 0xC0) != 0x80) {
+            m_resyncBytes = 0;
+            break;
+        }
+        ++begin;
+        --m_resyncBytes;
+    }
+    if (begin == end) return;
+    const QString text = m_textDecoder->toUnicode(begin, int(end - begin));
+    if (!text.isEmpty()) {
+        if (m_stats != nullptr) {
+            m_stats->addTextQueued(text.size());
+        }
+        emit output(text);
+    }
+}
+
+inline void Worker::stampRows(SampleFrame& frame, const int size, const qint64 time) const {
+    // the bytes arrived some time after the previous buffer was read,
+    // but not earlier than the baud rate allows after an idle period
+    qint64 span = m_lastReadTime >= 0 ? qMax<qint64>(time - m_lastReadTime, 0) : 0;
+    if (m_byteTime > 0) {
+        span = qMin(span, m_byteTime * size);
+    }
+    const qint64 start = time - span;
+    frame.rowTimes.reserve(m_rowOffsets.size());
+    for (const int offset : m_rowOffsets) {
+        frame.rowTimes << start + qint64(span * (qreal(offset) / size));
+    }
+}
+
+void Worker::setInputMode(const int mode) {
+    m_inputMode = static_cast<InputMode>(mode);
+    m_parser.reset();
+    m_decoder.setFraming(m_inputMode == SlipInput ? FrameDecoder::Slip : FrameDecoder::Cobs);
+}
+
+void Worker::setMonitorMode(const int mode) {
+    const bool decoding = m_monitorMode == MonitorLive && m_monitorFormat == TextFormat;
+    m_monitorMode = static_cast<MonitorMode>(mode);
+    updateTextDecoder(decoding);
+}
+
+void Worker::setMonitorFormat(const int format) {
+    const bool decoding = m_monitorMode == MonitorLive && m_monitorFormat == TextFormat;
+    m_monitorFormat = static_cast<MonitorFormat>(format);
+    updateTextDecoder(decoding);
+}
+
+inline void Worker::updateTextDecoder(const bool decoding) {
+    if (decoding == (m_monitorMode == MonitorLive && m_monitorFormat == TextFormat)) return;
+    if (decoding) {
+        // a partial sequence kept by the decoder is never completed
+        m_textDecoder.reset(QTextCodec::codecForMib(UTF8MIB)->makeDecoder(QTextCodec::IgnoreHeader));
+    } else {
+        m_resyncBytes = MAXCONTINUATIONBYTES;
+    }
+}
+
+void Worker::setBaudRate(const qint32 baudRate) {
+    m_byteTime = baudRate > 0 ? qint64(1000000000) * BITSPERBYTE / baudRate : 0;
 }
@@ -11,6 +11,12 @@
 #define WORKER_H
 
 #include <QObject>
+#include <QScopedPointer>
+#include <QTextDecoder>
+#include "framedecoder.h"
+#include "lineparser.h"
+#include "pipelinestats.h"
+#include "sampleframe.h"
 
 class Worker : public QObject
 {
@@ -21,28 +27,191 @@ public:
      */
     Worker();
 
+    /**
+     * How the input is turned into samples for the plotter
+     */
+    enum InputMode {
+        TextInput,
+        CobsInput,
+        SlipInput
+    };
+
+    /**
+     * What the monitor does with the input as text
+     */
+    enum MonitorMode {
+        // the monitor is hidden, no text is decoded
+        MonitorOff,
+        // the monitor keeps what it shows, no text is decoded
+        MonitorPaused,
+        // every buffer is decoded and sent to the monitor
+        MonitorLive
+    };
+
+    /**
+     * How the live monitor shows the input
+     */
+    enum MonitorFormat {
+        // decoded as UTF-8 text
+        TextFormat,
+        // as raw bytes, which are never decoded
+        HexFormat
+    };
+
     /**
      * Whether the plotter is enabled, set by main thread
      */
     bool plotEnabled;
 
+    /**
+     * Sets the counters the worker adds to, call before the worker is moved to its thread
+     *
+     * @param stats the counters, or nullptr to count nothing
+     */
+    void setStats(PipelineStats* stats) { m_stats = stats; }
+
 signals:
+    /**
+     * Sends the text decoded from one input buffer to the monitor, only while it is live
+     *
+     * @param val the decoded text, never ending in a partial UTF-8 sequence
+     */
     void output(const QString& val);
-    void plotPoint(const qreal, const int, const bool);
+
+    /**
+     * Sends one input buffer as is to the monitor, only while it is live and shows hex
+     *
+     * @param buf the input buffer
+     */
+    void outputBytes(const QByteArray& buf);
+    /**
+     * Sends all rows parsed from one input buffer to the plotter at once
+     *
+     * @param frame the parsed rows
+     */
+    void plotFrame(const SampleFrame& frame);
 
 public slots:
     /**
-     * Processes the given buffer, and scans and parses numbers when the plotter is enabled
+     * Processes the given buffer, sending it to the monitor when it is live,
+     * and scanning and parsing numbers when the plotter is enabled
+     *
+     * Every parsed row is stamped with a time interpolated between the previous buffer
+     * and this one, by the position of its end in the buffer
      *
      * @param buf the input buffer
+     * @param time when the buffer was read in ns of MonotonicClock, or -1 for now
+     */
+    void processData(const QByteArray& buf, const qint64 time = -1);
+
+    /**
+     * Changes how the input is turned into samples, dropping any partial line or frame
+     *
+     * @param mode one of InputMode
+     */
+    void setInputMode(const int mode);
+
+    /**
+     * Changes what the monitor does with the input as text
+     *
+     * Text read while the monitor isn't live is never decoded, and once it is live again,
+     * decoding resumes at the next complete UTF-8 sequence
+     *
+     * @param mode one of MonitorMode
+     */
+    void setMonitorMode(const int mode);
+
+    /**
+     * Changes how the live monitor shows the input
+     *
+     * @param format one of MonitorFormat
+     */
+    void setMonitorFormat(const int format);
+
+    /**
+     * Sets the baud rate of the input, which bounds how long ago the bytes of a buffer arrived
+     *
+     * @param baudRate the baud rate, or 0 when unknown
      */
-    void processData(const QByteArray& buf);
+    void setBaudRate(const qint32 baudRate);
 
 private:
     /**
-     * Data left over from the last job when scanning for numbers
+     * How the input is turned into samples
+     */
+    InputMode m_inputMode;
+
+    /**
+     * What the monitor does with the input as text
+     */
+    MonitorMode m_monitorMode;
+
+    /**
+     * How the live monitor shows the input
+     */
+    MonitorFormat m_monitorFormat;
+
+    /**
+     * Decodes UTF-8 for the monitor, keeping sequences broken up into separate packets between jobs
+     */
+    QScopedPointer<QTextDecoder> m_textDecoder;
+
+    /**
+     * How many continuation bytes at the start of the next buffer may still be skipped,
+     * because the start of their UTF-8 sequence wasn't decoded
+     */
+    int m_resyncBytes;
+
+    /**
+     * Scans the input for numbers, keeping partial lines between jobs
+     */
+    LineParser m_parser;
+
+    /**
+     * Decodes binary frames, keeping partial frames between jobs
+     */
+    FrameDecoder m_decoder;
+
+    /**
+     * Counters of the pipeline, not owned by the worker
+     */
+    PipelineStats* m_stats;
+
+    /**
+     * Time the previous buffer was read, in ns, or -1 before the first one
+     */
+    qint64 m_lastReadTime;
+
+    /**
+     * Time it takes to receive one byte at the baud rate, in ns, or 0 when unknown
+     */
+    qint64 m_byteTime;
+
+    /**
+     * Scratch space for the offsets of the row ends in a buffer, reused between jobs
+     */
+    QVector<int> m_rowOffsets;
+
+    /**
+     * Resets the text decoder when decoding stops, and skips any partial sequence when it starts again
+     *
+     * @param decoding whether text was decoded before the monitor mode or format changed
+     */
+    inline void updateTextDecoder(const bool decoding);
+
+    /**
+     * Decodes the buffer and sends the text to the monitor
+     */
+    inline void outputText(const QByteArray& buf);
+
+    /**
+     * Stamps every row of the frame by interpolating over the time the buffer took to arrive
+     *
+     * @param frame the rows parsed from the buffer, their ends in `m_rowOffsets`
+     * @param size the size of the buffer
+     * @param time when the buffer was read
      */
-    QString m_leftover;
+    inline void stampRows(SampleFrame& frame, const int size, const qint64 time) const;
 };
 
 #endif // WORKER_H
@@ -26,14 +26,37 @@ DEFINES += QT_DEPRECATED_WARNINGS
 SOURCES += \
         main.cpp \
         mainwindow.cpp \
+    bytering.cpp \
+    captureplayer.cpp \
+    capturewriter.cpp \
+    channeltable.cpp \
+    decimator.cpp \
+    delimiterscanner.cpp \
+    framedecoder.cpp \
+    headlessstreamer.cpp \
+    hexview.cpp \
+    lineparser.cpp \
+    linesearcher.cpp \
+    linestore.cpp \
+    logview.cpp \
+    monotonicclock.cpp \
+    outputqueue.cpp \
+    pipelinestats.cpp \
     plotterview.cpp \
+    portreader.cpp \
+    rowview.cpp \
+    samplebuffer.cpp \
+    timebuffer.cpp \
+    windowextremes.cpp \
     worker.cpp
 
 test {
     SOURCES -= main.cpp
-    SOURCES += tests/test.cpp
+    SOURCES += tests/test.cpp \
+        tests/ptyloopback.cpp
 
-    HEADERS += tests/test.h
+    HEADERS += tests/test.h \
+        tests/ptyloopback.h
 
     TARGET = test
 
@@ -44,9 +67,44 @@ test {
     LIBS += -lgcov
 }
 
+bench {
+    SOURCES -= main.cpp
+    SOURCES += benchmarks/benchmark.cpp
+
+    HEADERS += benchmarks/benchmark.h
+
+    TARGET = benchmark
+
+    CONFIG -= debug
+    CONFIG += release
+}
+
 HEADERS += \
         mainwindow.h \
+    bytering.h \
+    captureformat.h \
+    captureplayer.h \
+    capturewriter.h \
+    channeltable.h \
+    decimator.h \
+    delimiterscanner.h \
+    framedecoder.h \
+    headlessstreamer.h \
+    hexview.h \
+    lineparser.h \
+    linesearcher.h \
+    linestore.h \
+    logview.h \
+    monotonicclock.h \
+    outputqueue.h \
+    pipelinestats.h \
     plotterview.h \
+    portreader.h \
+    rowview.h \
+    samplebuffer.h \
+    sampleframe.h \
+    timebuffer.h \
+    windowextremes.h \
     worker.h
 
 FORMS += \